@@ -0,0 +1,258 @@
+#include "llllib.h"
+#include "lll_checkpoint.h"
+#include <stdexcept>
+#include <algorithm>
+#include <ostream>
+#include <cmath>
+
+// ─── BKZ Block Reduction ─────────────────────────────────────────────────
+
+namespace {
+
+// Rational → long double without overflowing through double
+long double to_long_double(const Rational& q) {
+    long en, ed;
+    double dn = mpz_get_d_2exp(&en, q.get_num_mpz_t());
+    double dd = mpz_get_d_2exp(&ed, q.get_den_mpz_t());
+    return std::ldexp(static_cast<long double>(dn) / dd, static_cast<int>(en - ed));
+}
+
+// log2 of a positive Rational, for progress reports
+double log2_rational(const Rational& q) {
+    long en, ed;
+    double dn = mpz_get_d_2exp(&en, q.get_num_mpz_t());
+    double dd = mpz_get_d_2exp(&ed, q.get_den_mpz_t());
+    return std::log2(dn / dd) + static_cast<double>(en - ed);
+}
+
+/*
+ * Pruned Schnorr–Euchner enumeration on the projected block
+ * π_j(b_j), ..., π_j(b_{j+d-1}). Norms are taken relative to ||b*_j||², so
+ * the search radius is just delta. Returns true and sets x when a non-zero
+ * combination shorter than the radius was found.
+ */
+bool enumerate_block(const GramSchmidtResult& gs, size_t j, size_t d,
+                     long double radius, double pruning, std::vector<long>& best_x) {
+    std::vector<long double> r(d);
+    std::vector<std::vector<long double>> mu(d, std::vector<long double>(d, 0.0L));
+    for (size_t i = 0; i < d; ++i) {
+        r[i] = to_long_double(gs.normsq[j+i] / gs.normsq[j]);
+        for (size_t t = 0; t < i; ++t) {
+            mu[i][t] = to_long_double(gs.mu[j+i][j+t]);
+        }
+    }
+
+    // Linear pruning: fraction of the radius allowed at level k
+    std::vector<long double> factor(d);
+    for (size_t k = 0; k < d; ++k) {
+        long double fixed = static_cast<long double>(d - k) / d;
+        factor[k] = 1.0L - pruning * (1.0L - fixed);
+    }
+
+    std::vector<long> x(d, 0), dx(d, 0), ddx(d, -1);
+    std::vector<long double> c(d, 0.0L), l(d + 1, 0.0L);
+    long double best = radius;
+    bool found = false;
+
+    // Next candidate at level k: only x_k > 0 while everything above is
+    // zero (±v symmetry), otherwise zig-zag around the centre c_k.
+    auto next = [&](size_t k) {
+        if (l[k+1] == 0.0L) {
+            x[k]++;
+        } else {
+            ddx[k] = -ddx[k];
+            dx[k] = ddx[k] - dx[k];
+            x[k] += dx[k];
+        }
+    };
+
+    size_t k = d - 1;
+    for (;;) {
+        long double diff = x[k] - c[k];
+        l[k] = l[k+1] + diff * diff * r[k];
+
+        if (l[k] < best * factor[k]) {
+            if (k == 0) {
+                if (l[0] > 0.0L) {
+                    best = l[0];
+                    best_x = x;
+                    found = true;
+                }
+                next(0);
+            } else {
+                --k;
+                long double centre = 0.0L;
+                for (size_t i = k + 1; i < d; ++i) {
+                    centre -= x[i] * mu[i][k];
+                }
+                c[k] = centre;
+                x[k] = std::lround(centre);
+                dx[k] = 0;
+                ddx[k] = (centre >= x[k]) ? -1 : 1;
+            }
+        } else {
+            if (++k == d) break;
+            next(k);
+        }
+    }
+    return found;
+}
+
+// Exact ||π_j(Σ x_i b_{j+i})||² from the GSO
+Rational projected_norm(const GramSchmidtResult& gs, size_t j, const std::vector<long>& x) {
+    size_t d = x.size();
+    Rational norm = 0;
+    for (size_t i = 0; i < d; ++i) {
+        Rational coord = 0;
+        for (size_t t = i; t < d; ++t) {
+            coord += (t == i) ? Rational(x[t]) : x[t] * gs.mu[j+t][j+i];
+        }
+        norm += coord * coord * gs.normsq[j+i];
+    }
+    return norm;
+}
+
+/*
+ * Make Σ x_i b_{j+i} the row at position j with a unimodular transform of
+ * rows j..j+d-1: Euclid on the coefficients, mirrored as row additions,
+ * leaves a single coefficient ±1 whose row is then moved up to j.
+ */
+void insert_vector(Matrix& B, size_t j, const std::vector<long>& coeffs) {
+    size_t d = coeffs.size();
+    std::vector<mpz_class> x(d);
+    mpz_class g = 0;
+    for (size_t i = 0; i < d; ++i) {
+        x[i] = coeffs[i];
+        mpz_gcd(g.get_mpz_t(), g.get_mpz_t(), x[i].get_mpz_t());
+    }
+    for (auto& xi : x) {
+        mpz_divexact(xi.get_mpz_t(), xi.get_mpz_t(), g.get_mpz_t());
+    }
+
+    size_t a;
+    for (;;) {
+        a = d;
+        for (size_t i = 0; i < d; ++i) {
+            if (x[i] != 0 && (a == d || abs(x[i]) < abs(x[a]))) a = i;
+        }
+        bool single = true;
+        for (size_t b = 0; b < d; ++b) {
+            if (b == a || x[b] == 0) continue;
+            single = false;
+            // x_a b_a + x_b b_b = x_a (b_a + q b_b) + (x_b − q x_a) b_b
+            mpz_class q = x[b] / x[a];
+            x[b] -= q * x[a];
+            row_submul(B[j+a], B[j+b], mpz_class(-q));
+        }
+        if (single) break;
+    }
+
+    if (x[a] < 0) {
+        for (auto& e : B[j+a]) e = -e;
+    }
+    for (size_t t = a; t > 0; --t) {
+        B.swap_rows(j + t, j + t - 1);
+    }
+}
+
+/*
+ * The BKZ driver. A resume state (from a checkpoint) either re-enters the
+ * LLL preprocessing at its loop index or skips straight to its tour and
+ * block; the GSO is recomputed from the saved basis in both cases.
+ */
+BKZResult run_bkz(Matrix B, const BKZParams& params, const CheckpointState* resume) {
+    if (params.block_size < 2) {
+        throw std::invalid_argument("BKZ block size must be at least 2");
+    }
+    for (size_t i = 0; i < B.rows(); ++i) {
+        for (auto& elem : B[i]) {
+            elem.canonicalize();
+        }
+    }
+
+    CheckpointWriter checkpoint(params.checkpoint, "bkz", params.delta);
+    checkpoint.state().block_size = params.block_size;
+    bool in_tours = resume && resume->tour > 0;
+
+    // Preprocessing
+    GramSchmidtResult gs = gram_schmidt(B);
+    BKZResult result;
+    if (in_tours) {
+        result.tour_norms = resume->tour_norms;
+    } else {
+        lll1_in_place(B, gs, params.delta, nullptr, checkpoint, resume ? resume->k : 1);
+        result.tour_norms.push_back(gs.normsq[0]);
+        if (params.progress) {
+            *params.progress << "BKZ-" << params.block_size << " after LLL: log2 ||b_0|| = "
+                             << log2_rational(gs.normsq[0]) / 2 << "\n";
+        }
+    }
+
+    size_t n = B.rows();
+    long double radius = to_long_double(params.delta);
+    std::vector<long> x;
+
+    for (size_t tour = in_tours ? resume->tour : 1;; ++tour) {
+        bool changed = in_tours && tour == resume->tour && resume->changed;
+        size_t first = (in_tours && tour == resume->tour) ? resume->j : 0;
+        for (size_t j = first; j + 1 < n; ++j) {
+            if (checkpoint.due()) {
+                CheckpointState& state = checkpoint.state();
+                state.tour = tour;
+                state.j = j;
+                state.changed = changed;
+                state.tour_norms = result.tour_norms;
+                checkpoint.write(B, 1);
+            }
+
+            size_t d = std::min(params.block_size, n - j);
+            if (!enumerate_block(gs, j, d, radius, params.pruning, x)) continue;
+            // Floating-point enumeration only proposes; insert on exact proof
+            if (projected_norm(gs, j, x) >= params.delta * gs.normsq[j]) continue;
+
+            insert_vector(B, j, x);
+            gs = gram_schmidt(B);
+            lll1_in_place(B, gs, params.delta);
+            changed = true;
+        }
+
+        const Rational& previous = result.tour_norms.back();
+        Rational current = gs.normsq[0];
+        bool improved = current < previous;
+        result.tour_norms.push_back(current);
+        if (params.progress) {
+            *params.progress << "BKZ-" << params.block_size << " tour " << tour
+                             << ": log2 ||b_0|| = " << log2_rational(current) / 2
+                             << (changed ? "" : " (no change)") << "\n";
+        }
+
+        if (!changed) break;
+        if (params.max_tours != 0 && tour >= params.max_tours) break;
+        if (params.early_abort && !improved) break;
+    }
+
+    checkpoint.finish();
+    result.basis = std::move(B);
+    return result;
+}
+
+} // namespace
+
+BKZResult bkz(Matrix B, const BKZParams& params) {
+    return run_bkz(std::move(B), params, nullptr);
+}
+
+BKZResult bkz_resume(const BKZParams& params) {
+    CheckpointState state = read_checkpoint(params.checkpoint.path);
+    if (state.algorithm != "bkz") {
+        throw std::invalid_argument("Not a BKZ checkpoint: " + params.checkpoint.path);
+    }
+    if (state.block_size != params.block_size) {
+        throw std::invalid_argument("Checkpoint was written with a different BKZ block size");
+    }
+    if (state.delta != params.delta) {
+        throw std::invalid_argument("Checkpoint was written with a different delta");
+    }
+    Matrix B = std::move(state.basis);
+    return run_bkz(std::move(B), params, &state);
+}
@@ -0,0 +1,211 @@
+#include "llllib.h"
+#include "lll_checkpoint.h"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+// ─── Checkpoint Files ────────────────────────────────────────────────────
+
+/*
+ * Text format, whitespace-separated, Rationals in base 10:
+ *
+ *     llllib-checkpoint 2
+ *     algorithm <lll1|bkz>
+ *     k <k>
+ *     delta <delta>
+ *     bkz <block_size> <tour> <j> <changed>
+ *     tour_norms <count> <q_0> ... <q_{count-1}>
+ *     basis <n> <m>
+ *     <n rows of m entries>
+ */
+
+namespace {
+
+const char* const magic = "llllib-checkpoint";
+const int format_version = 2;
+
+void write_file(const std::string& path, const CheckpointState& state, const Matrix& B) {
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Could not open checkpoint file: " + tmp_path);
+        }
+        out << magic << " " << format_version << "\n"
+            << "algorithm " << state.algorithm << "\n"
+            << "k " << state.k << "\n"
+            << "delta " << state.delta << "\n"
+            << "bkz " << state.block_size << " " << state.tour << " " << state.j
+            << " " << (state.changed ? 1 : 0) << "\n"
+            << "tour_norms " << state.tour_norms.size();
+        for (const auto& q : state.tour_norms) {
+            out << " " << q;
+        }
+        out << "\nbasis " << B.rows() << " " << B.cols() << "\n";
+        for (size_t i = 0; i < B.rows(); ++i) {
+            for (size_t j = 0; j < B.cols(); ++j) {
+                out << (j ? " " : "") << B[i][j];
+            }
+            out << "\n";
+        }
+        out.close();
+        if (!out) {
+            std::remove(tmp_path.c_str());
+            throw std::runtime_error("Could not write checkpoint file: " + tmp_path);
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        throw std::runtime_error("Could not replace checkpoint file: " + path);
+    }
+}
+
+void expect(std::istream& in, const std::string& keyword, const std::string& path) {
+    std::string word;
+    if (!(in >> word) || word != keyword) {
+        throw std::runtime_error("Malformed checkpoint file " + path + ": expected " + keyword);
+    }
+}
+
+template <typename T>
+void read_value(std::istream& in, T& value, const std::string& path) {
+    if (!(in >> value)) {
+        throw std::runtime_error("Malformed checkpoint file " + path);
+    }
+}
+
+void read_rational(std::istream& in, Rational& q, const std::string& path) {
+    std::string token;
+    // set_str accepts "1/0", which canonicalize would divide by
+    if (!(in >> token) || q.set_str(token, 10) != 0 || q.get_den() == 0) {
+        throw std::runtime_error("Malformed checkpoint file " + path + ": bad number");
+    }
+    q.canonicalize();
+}
+
+void malformed(const std::string& path, const std::string& what) {
+    throw std::runtime_error("Malformed checkpoint file " + path + ": " + what);
+}
+
+// Bytes left in the file; every entry still to come takes at least one,
+// which bounds the sizes in the file before anything is allocated
+size_t remaining(std::istream& in, std::streamoff size) {
+    std::streamoff pos = in.tellg();
+    return pos < 0 || pos > size ? 0 : static_cast<size_t>(size - pos);
+}
+
+} // namespace
+
+void write_checkpoint(const std::string& path, const CheckpointState& state) {
+    write_file(path, state, state.basis);
+}
+
+CheckpointState read_checkpoint(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Could not open checkpoint file: " + path);
+    }
+    in.seekg(0, std::ios::end);
+    std::streamoff size = in.tellg();
+    in.seekg(0);
+
+    CheckpointState state;
+    int version = 0;
+    expect(in, magic, path);
+    read_value(in, version, path);
+    if (version != format_version) {
+        throw std::runtime_error("Unsupported checkpoint version in " + path);
+    }
+    expect(in, "algorithm", path);
+    read_value(in, state.algorithm, path);
+    if (state.algorithm != "lll1" && state.algorithm != "bkz") {
+        malformed(path, "unknown algorithm " + state.algorithm);
+    }
+    expect(in, "k", path);
+    read_value(in, state.k, path);
+    expect(in, "delta", path);
+    read_rational(in, state.delta, path);
+    expect(in, "bkz", path);
+    int changed = 0;
+    read_value(in, state.block_size, path);
+    read_value(in, state.tour, path);
+    read_value(in, state.j, path);
+    read_value(in, changed, path);
+    state.changed = changed != 0;
+
+    expect(in, "tour_norms", path);
+    size_t count = 0;
+    read_value(in, count, path);
+    if (count > remaining(in, size)) {
+        malformed(path, "tour_norms count exceeds the file");
+    }
+    state.tour_norms.resize(count);
+    for (auto& q : state.tour_norms) {
+        read_rational(in, q, path);
+    }
+
+    expect(in, "basis", path);
+    size_t n = 0, m = 0;
+    read_value(in, n, path);
+    read_value(in, m, path);
+    if (n == 0 || m == 0) {
+        malformed(path, "empty basis");
+    }
+    if (n > remaining(in, size) / m) {
+        malformed(path, "basis dimensions exceed the file");
+    }
+
+    // The loop positions must lie inside the basis, and a BKZ tour carries
+    // ||b_0||² after the LLL preprocessing and after each finished tour
+    if (state.k == 0 || state.k > n) {
+        malformed(path, "loop index k outside the basis");
+    }
+    if (state.algorithm == "bkz") {
+        if (state.block_size < 2) {
+            malformed(path, "BKZ block size below 2");
+        }
+        if (state.tour > 0 && (state.j >= n || state.tour_norms.size() != state.tour)) {
+            malformed(path, "BKZ tour position does not match the basis and tour_norms");
+        }
+    } else if (state.block_size != 0 || state.tour != 0 || !state.tour_norms.empty()) {
+        malformed(path, "BKZ fields in an lll1 checkpoint");
+    }
+
+    state.basis = Matrix(n, m);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            read_rational(in, state.basis[i][j], path);
+        }
+    }
+    return state;
+}
+
+// ─── Checkpoint Writer ───────────────────────────────────────────────────
+
+CheckpointWriter::CheckpointWriter(const CheckpointParams& params, const std::string& algorithm,
+                                   const Rational& delta)
+    : params_(params) {
+    state_.algorithm = algorithm;
+    state_.delta = delta;
+    schedule();
+}
+
+void CheckpointWriter::schedule() {
+    next_ = std::chrono::steady_clock::now()
+          + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(params_.interval_seconds));
+}
+
+void CheckpointWriter::write(const Matrix& B, size_t k) {
+    state_.k = k;
+    write_file(params_.path, state_, B);
+    // Measure the interval from the end of the write, so a slow disk can
+    // never take more than the interval's share of the run
+    schedule();
+}
+
+void CheckpointWriter::finish() {
+    if (enabled()) {
+        std::remove(params_.path.c_str());
+    }
+}
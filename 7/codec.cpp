@@ -0,0 +1,206 @@
+#include "codec.h"
+#include <stdexcept>
+
+// ─── Integers and Bytes ──────────────────────────────────────────────────
+
+Bytes to_bytes(const mpz_class& x) {
+    if (x < 0) {
+        throw std::invalid_argument("Cannot encode a negative integer as bytes");
+    }
+    Bytes bytes((mpz_sizeinbase(x.get_mpz_t(), 2) + 7) / 8);
+    size_t count = 0;
+    mpz_export(bytes.data(), &count, 1, 1, 1, 0, x.get_mpz_t());
+    bytes.resize(count);   // 0 for x = 0, where sizeinbase still says 1
+    return bytes;
+}
+
+mpz_class from_bytes(const unsigned char* data, size_t size) {
+    mpz_class x;
+    mpz_import(x.get_mpz_t(), size, 1, 1, 1, 0, data);
+    return x;
+}
+
+mpz_class from_bytes(const Bytes& bytes) {
+    return from_bytes(bytes.data(), bytes.size());
+}
+
+std::string to_text(const mpz_class& x) {
+    Bytes bytes = to_bytes(x);
+    return std::string(bytes.begin(), bytes.end());
+}
+
+mpz_class from_text(const std::string& text) {
+    return from_bytes(reinterpret_cast<const unsigned char*>(text.data()), text.size());
+}
+
+// ─── Hex and Base64 ──────────────────────────────────────────────────────
+
+namespace {
+
+const char hex_digits[] = "0123456789abcdef";
+const char base64_alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+int base64_value(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+std::string trimmed(const std::string& s) {
+    size_t first = s.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) return std::string();
+    size_t last = s.find_last_not_of(" \t\r\n");
+    return s.substr(first, last - first + 1);
+}
+
+} // namespace
+
+std::string to_hex(const Bytes& bytes) {
+    std::string hex;
+    hex.reserve(2 * bytes.size());
+    for (unsigned char b : bytes) {
+        hex.push_back(hex_digits[b >> 4]);
+        hex.push_back(hex_digits[b & 0xf]);
+    }
+    return hex;
+}
+
+Bytes from_hex(const std::string& hex) {
+    if (hex.size() % 2 != 0) {
+        throw std::invalid_argument("Hex string must have an even length");
+    }
+    Bytes bytes(hex.size() / 2);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        int hi = hex_value(hex[2*i]);
+        int lo = hex_value(hex[2*i + 1]);
+        if (hi < 0 || lo < 0) {
+            throw std::invalid_argument("Invalid hex digit");
+        }
+        bytes[i] = static_cast<unsigned char>(hi << 4 | lo);
+    }
+    return bytes;
+}
+
+std::string to_base64(const Bytes& bytes) {
+    std::string out;
+    out.reserve((bytes.size() + 2) / 3 * 4);
+    size_t i = 0;
+    for (; i + 3 <= bytes.size(); i += 3) {
+        unsigned long v = (unsigned long)bytes[i] << 16 | bytes[i+1] << 8 | bytes[i+2];
+        out.push_back(base64_alphabet[v >> 18 & 63]);
+        out.push_back(base64_alphabet[v >> 12 & 63]);
+        out.push_back(base64_alphabet[v >> 6 & 63]);
+        out.push_back(base64_alphabet[v & 63]);
+    }
+    size_t rest = bytes.size() - i;
+    if (rest > 0) {
+        unsigned long v = (unsigned long)bytes[i] << 16;
+        if (rest == 2) v |= bytes[i+1] << 8;
+        out.push_back(base64_alphabet[v >> 18 & 63]);
+        out.push_back(base64_alphabet[v >> 12 & 63]);
+        out.push_back(rest == 2 ? base64_alphabet[v >> 6 & 63] : '=');
+        out.push_back('=');
+    }
+    return out;
+}
+
+Bytes from_base64(const std::string& base64) {
+    if (base64.size() % 4 != 0) {
+        throw std::invalid_argument("Base64 length must be a multiple of 4");
+    }
+    size_t padding = 0;
+    if (!base64.empty() && base64.back() == '=') {
+        padding = base64[base64.size() - 2] == '=' ? 2 : 1;
+    }
+
+    Bytes bytes;
+    bytes.reserve(base64.size() / 4 * 3);
+    for (size_t i = 0; i < base64.size(); i += 4) {
+        bool last = i + 4 == base64.size();
+        unsigned long v = 0;
+        for (size_t j = 0; j < 4; ++j) {
+            int digit = (last && j >= 4 - padding) ? 0 : base64_value(base64[i + j]);
+            if (digit < 0) {
+                throw std::invalid_argument("Invalid base64 character");
+            }
+            v = v << 6 | digit;
+        }
+        bytes.push_back(static_cast<unsigned char>(v >> 16));
+        if (!last || padding < 2) bytes.push_back(static_cast<unsigned char>(v >> 8 & 0xff));
+        if (!last || padding < 1) bytes.push_back(static_cast<unsigned char>(v & 0xff));
+    }
+    return bytes;
+}
+
+// ─── Streaming ───────────────────────────────────────────────────────────
+
+Encoding parse_encoding(const std::string& name) {
+    if (name == "decimal") return Encoding::Decimal;
+    if (name == "hex") return Encoding::Hex;
+    if (name == "base64") return Encoding::Base64;
+    if (name == "text") return Encoding::Text;
+    throw std::invalid_argument("Unknown encoding " + name);
+}
+
+bool IntegerReader::next(mpz_class& x) {
+    while (std::getline(in_, buffer_)) {
+        ++line_;
+        std::string token = trimmed(buffer_);
+        if (token.empty() || token[0] == '#') continue;
+
+        try {
+            switch (encoding_) {
+                case Encoding::Decimal:
+                    if (x.set_str(token, 10) != 0) {
+                        throw std::invalid_argument("Invalid decimal number");
+                    }
+                    break;
+                case Encoding::Hex:
+                    x = from_bytes(from_hex(token));
+                    break;
+                case Encoding::Base64:
+                    x = from_bytes(from_base64(token));
+                    break;
+                case Encoding::Text:
+                    x = from_text(token);
+                    break;
+            }
+        } catch (const std::invalid_argument& e) {
+            throw std::runtime_error("Line " + std::to_string(line_) + ": " + e.what());
+        }
+        return true;
+    }
+    return false;
+}
+
+void write_integer(std::ostream& out, const mpz_class& x, Encoding encoding) {
+    // Zero has no bytes, but an empty line would be skipped by
+    // IntegerReader and shift every later value, so it is one zero byte
+    auto line_bytes = [&] { return x == 0 ? Bytes{0} : to_bytes(x); };
+    switch (encoding) {
+        case Encoding::Decimal: out << x; break;
+        case Encoding::Hex: out << to_hex(line_bytes()); break;
+        case Encoding::Base64: out << to_base64(line_bytes()); break;
+        case Encoding::Text: {
+            Bytes bytes = line_bytes();
+            out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            break;
+        }
+    }
+}
+
+void write_bytes(std::ostream& out, const mpz_class& x) {
+    Bytes bytes = to_bytes(x);
+    out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
@@ -0,0 +1,114 @@
+#ifndef CODEC_H
+#define CODEC_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <gmpxx.h>
+
+// Conversions between non-negative integers and byte strings. Integers
+// are big-endian: the most significant byte comes first, exactly as the
+// lab's plaintext m = Σ byte_i · 256^(len−1−i). Every conversion is a
+// single mpz_export / mpz_import plus one pass over the bytes.
+
+using Bytes = std::vector<unsigned char>;
+
+// ─── Integers and Bytes ──────────────────────────────────────────────────
+
+/**
+ * Minimal big-endian byte string of x (empty for x = 0).
+ * @throws std::invalid_argument if x is negative.
+ */
+Bytes to_bytes(const mpz_class& x);
+
+/**
+ * Integer whose big-endian byte string is data[0..size).
+ */
+mpz_class from_bytes(const unsigned char* data, size_t size);
+mpz_class from_bytes(const Bytes& bytes);
+
+/**
+ * Plaintext integer as text, one character per byte.
+ */
+std::string to_text(const mpz_class& x);
+
+/**
+ * Inverse of to_text.
+ */
+mpz_class from_text(const std::string& text);
+
+// ─── Hex and Base64 ──────────────────────────────────────────────────────
+
+/**
+ * Lower-case hex, two digits per byte.
+ */
+std::string to_hex(const Bytes& bytes);
+
+/**
+ * Bytes from hex of even length (either case).
+ * @throws std::invalid_argument on an odd length or a non-hex digit.
+ */
+Bytes from_hex(const std::string& hex);
+
+/**
+ * Standard base64 (RFC 4648 alphabet) with '=' padding.
+ */
+std::string to_base64(const Bytes& bytes);
+
+/**
+ * Bytes from padded base64.
+ * @throws std::invalid_argument if the length is not a multiple of 4 or
+ *         a character is outside the alphabet.
+ */
+Bytes from_base64(const std::string& base64);
+
+// ─── Streaming ───────────────────────────────────────────────────────────
+
+// Text is the to_text / from_text form: one character per byte.
+enum class Encoding { Decimal, Hex, Base64, Text };
+
+/**
+ * Parse "decimal", "hex", "base64" or "text".
+ * @throws std::invalid_argument for any other name.
+ */
+Encoding parse_encoding(const std::string& name);
+
+/**
+ * Reads one integer per line from a stream of any size, holding only the
+ * current line in memory. Blank lines and lines starting with '#' are
+ * skipped, and surrounding whitespace is ignored (also for Text).
+ */
+class IntegerReader {
+public:
+    IntegerReader(std::istream& in, Encoding encoding) : in_(in), encoding_(encoding) {}
+
+    /**
+     * Read the next integer.
+     * @return false at the end of the input.
+     * @throws std::runtime_error on a malformed line (with its line number).
+     */
+    bool next(mpz_class& x);
+
+    size_t line() const { return line_; }
+
+private:
+    std::istream& in_;
+    Encoding encoding_;
+    size_t line_ = 0;
+    std::string buffer_;
+};
+
+/**
+ * Write x in the given encoding, without a trailing newline. Zero is
+ * written as one zero byte ("00", "AA==", or a NUL character for Text), so
+ * every value is a non-blank line that IntegerReader reads back.
+ */
+void write_integer(std::ostream& out, const mpz_class& x, Encoding encoding);
+
+/**
+ * Write the raw big-endian bytes of x (nothing for x = 0).
+ */
+void write_bytes(std::ostream& out, const mpz_class& x);
+
+#endif // CODEC_H
@@ -0,0 +1,467 @@
+#include "coppersmith.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+// ─── Polynomial Helpers ──────────────────────────────────────────────────
+
+long degree(const Polynomial& f) {
+    long d = static_cast<long>(f.size()) - 1;
+    while (d >= 0 && f[d] == 0) --d;
+    return d;
+}
+
+Polynomial poly_mul(const Polynomial& f, const Polynomial& g) {
+    if (f.empty() || g.empty()) return {};
+    Polynomial h(f.size() + g.size() - 1, 0);
+    for (size_t i = 0; i < f.size(); ++i) {
+        if (f[i] == 0) continue;
+        for (size_t j = 0; j < g.size(); ++j) {
+            mpz_addmul(h[i+j].get_mpz_t(), f[i].get_mpz_t(), g[j].get_mpz_t());
+        }
+    }
+    return h;
+}
+
+mpz_class poly_eval(const Polynomial& f, const mpz_class& x) {
+    mpz_class result = 0;
+    for (size_t i = f.size(); i-- > 0;) {
+        result = result * x + f[i];
+    }
+    return result;
+}
+
+Polynomial poly_derivative(const Polynomial& f) {
+    long d = degree(f);
+    if (d < 1) return {};
+    Polynomial g(d);
+    for (long i = 1; i <= d; ++i) {
+        g[i-1] = f[i] * i;
+    }
+    return g;
+}
+
+namespace {
+
+// f with trailing zero coefficients removed
+Polynomial trimmed(Polynomial f) {
+    f.resize(degree(f) + 1);
+    return f;
+}
+
+// gcd of the coefficients of a trimmed, non-zero polynomial
+mpz_class content(const Polynomial& f) {
+    mpz_class g = 0;
+    for (const auto& c : f) {
+        mpz_gcd(g.get_mpz_t(), g.get_mpz_t(), c.get_mpz_t());
+        if (g == 1) break;
+    }
+    return g;
+}
+
+// Primitive part with a positive leading coefficient
+Polynomial primitive_part(Polynomial f) {
+    mpz_class g = content(f);
+    if (f.back() < 0) g = -g;
+    for (auto& c : f) {
+        mpz_divexact(c.get_mpz_t(), c.get_mpz_t(), g.get_mpz_t());
+    }
+    return f;
+}
+
+// f / g for a primitive g that divides f exactly over ℤ
+Polynomial poly_divexact(Polynomial f, const Polynomial& g) {
+    long df = degree(f);
+    long dg = degree(g);
+    Polynomial q(df - dg + 1);
+    for (long i = df - dg; i >= 0; --i) {
+        mpz_divexact(q[i].get_mpz_t(), f[i + dg].get_mpz_t(), g[dg].get_mpz_t());
+        for (long j = 0; j <= dg; ++j) {
+            mpz_submul(f[i + j].get_mpz_t(), q[i].get_mpz_t(), g[j].get_mpz_t());
+        }
+    }
+    return q;
+}
+
+// True if g divides f over ℤ (both trimmed, g non-zero)
+bool poly_divides(Polynomial f, const Polynomial& g) {
+    long dg = degree(g);
+    for (long df = degree(f); df >= dg; df = degree(f)) {
+        if (!mpz_divisible_p(f[df].get_mpz_t(), g[dg].get_mpz_t())) return false;
+        mpz_class q;
+        mpz_divexact(q.get_mpz_t(), f[df].get_mpz_t(), g[dg].get_mpz_t());
+        for (long j = 0; j <= dg; ++j) {
+            mpz_submul(f[df - dg + j].get_mpz_t(), q.get_mpz_t(), g[j].get_mpz_t());
+        }
+    }
+    return degree(f) < 0;
+}
+
+// Coefficients of f reduced into [0, M)
+Polynomial reduce_mod(const Polynomial& f, const mpz_class& M) {
+    Polynomial g(f.size());
+    for (size_t i = 0; i < f.size(); ++i) {
+        mpz_mod(g[i].get_mpz_t(), f[i].get_mpz_t(), M.get_mpz_t());
+    }
+    return g;
+}
+
+using ModPoly = std::vector<unsigned long>;
+
+unsigned long mul_mod(unsigned long a, unsigned long b, unsigned long p) {
+    return static_cast<unsigned long>(static_cast<unsigned long long>(a) * b % p);
+}
+
+unsigned long inv_mod(unsigned long a, unsigned long p) {
+    // Fermat: a^(p−2) mod p
+    unsigned long result = 1;
+    for (unsigned long e = p - 2; e; e >>= 1) {
+        if (e & 1) result = mul_mod(result, a, p);
+        a = mul_mod(a, a, p);
+    }
+    return result;
+}
+
+void trim(ModPoly& f) {
+    while (!f.empty() && f.back() == 0) f.pop_back();
+}
+
+// gcd over F_p, up to a unit
+ModPoly gcd_mod(ModPoly a, ModPoly b, unsigned long p) {
+    trim(a);
+    trim(b);
+    while (!b.empty()) {
+        unsigned long inv = inv_mod(b.back(), p);
+        while (a.size() >= b.size()) {
+            unsigned long factor = mul_mod(a.back(), inv, p);
+            size_t shift = a.size() - b.size();
+            for (size_t i = 0; i < b.size(); ++i) {
+                a[i + shift] = (a[i + shift] + p - mul_mod(factor, b[i], p)) % p;
+            }
+            trim(a);
+        }
+        std::swap(a, b);
+    }
+    return a;
+}
+
+// ⌈||f||₂⌉
+mpz_class norm_ceil(const Polynomial& f) {
+    mpz_class sum = 0;
+    for (const auto& c : f) {
+        mpz_addmul(sum.get_mpz_t(), c.get_mpz_t(), c.get_mpz_t());
+    }
+    mpz_class root;
+    mpz_sqrt(root.get_mpz_t(), sum.get_mpz_t());
+    return root + 1;
+}
+
+} // namespace
+
+Polynomial poly_gcd(const Polynomial& f, const Polynomial& g) {
+    Polynomial a = trimmed(f);
+    Polynomial b = trimmed(g);
+    if (a.empty()) return b.empty() ? b : primitive_part(b);
+    if (b.empty()) return primitive_part(a);
+    if (a.size() < b.size()) std::swap(a, b);
+
+    a = primitive_part(a);
+    b = primitive_part(b);
+    if (b.size() == 1) return {1};
+
+    // Multi-modular gcd. With γ = gcd(lc(a), lc(b)), γ times the monic
+    // gcd mod p is the image of (γ/lc(G))·G for the gcd G over ℤ, whose
+    // coefficients are below 2^deg(b)·||b||₂·|γ| by Mignotte's bound. The
+    // images for word-size primes are combined by CRT until their product
+    // exceeds twice that, and G is the primitive part of the symmetric
+    // residues. An unlucky prime gives a gcd of too high a degree: it is
+    // skipped once a lower degree has been seen, and a candidate built
+    // only from unlucky primes fails the exact division check, in which
+    // case more primes are added.
+    mpz_class gamma;
+    mpz_gcd(gamma.get_mpz_t(), a.back().get_mpz_t(), b.back().get_mpz_t());
+    mpz_class limit = std::min(norm_ceil(a), norm_ceil(b)) * gamma;
+    mpz_mul_2exp(limit.get_mpz_t(), limit.get_mpz_t(), b.size());
+
+    Polynomial G;          // CRT image of γ·gcd, coefficients in [0, M)
+    mpz_class M = 1;
+    mpz_class prime = 1ul << 31;
+    auto reduce_ui = [](const Polynomial& f, unsigned long p) {
+        ModPoly f_p(f.size());
+        for (size_t i = 0; i < f.size(); ++i) {
+            f_p[i] = mpz_fdiv_ui(f[i].get_mpz_t(), p);
+        }
+        return f_p;
+    };
+    for (;;) {
+        mpz_nextprime(prime.get_mpz_t(), prime.get_mpz_t());
+        unsigned long p = prime.get_ui();
+        unsigned long gamma_p = mpz_fdiv_ui(gamma.get_mpz_t(), p);
+        if (mpz_fdiv_ui(a.back().get_mpz_t(), p) == 0 || mpz_fdiv_ui(b.back().get_mpz_t(), p) == 0) {
+            continue;
+        }
+        ModPoly g_p = gcd_mod(reduce_ui(a, p), reduce_ui(b, p), p);
+        if (g_p.size() == 1) return {1};
+        if (!G.empty() && g_p.size() > G.size()) continue;
+        if (g_p.size() < G.size()) {
+            G.clear();
+            M = 1;
+        }
+
+        // g_p made monic and scaled by γ, then merged into G by CRT
+        unsigned long scale = mul_mod(gamma_p, inv_mod(g_p.back(), p), p);
+        unsigned long M_inv = inv_mod(mpz_fdiv_ui(M.get_mpz_t(), p), p);
+        G.resize(g_p.size());
+        for (size_t i = 0; i < g_p.size(); ++i) {
+            unsigned long target = mul_mod(g_p[i], scale, p);
+            unsigned long current = mpz_fdiv_ui(G[i].get_mpz_t(), p);
+            unsigned long step = mul_mod((target + p - current) % p, M_inv, p);
+            mpz_addmul_ui(G[i].get_mpz_t(), M.get_mpz_t(), step);
+        }
+        M *= p;
+        if (M <= limit) continue;
+
+        mpz_class half = M / 2;
+        Polynomial candidate = G;
+        for (auto& c : candidate) {
+            if (c > half) c -= M;
+        }
+        candidate = primitive_part(trimmed(std::move(candidate)));
+        if (poly_divides(a, candidate) && poly_divides(b, candidate)) return candidate;
+    }
+}
+
+// ─── Integer Roots ───────────────────────────────────────────────────────
+
+namespace {
+
+bool is_prime(unsigned long n) {
+    if (n < 2) return false;
+    for (unsigned long d = 2; d * d <= n; ++d) {
+        if (n % d == 0) return false;
+    }
+    return true;
+}
+
+unsigned long eval_mod(const ModPoly& f, unsigned long x, unsigned long p) {
+    unsigned long result = 0;
+    for (size_t i = f.size(); i-- > 0;) {
+        result = (mul_mod(result, x, p) + f[i]) % p;
+    }
+    return result;
+}
+
+// f(x) mod M with the coefficients already reduced mod M
+mpz_class eval_mod(const Polynomial& f, const mpz_class& x, const mpz_class& M) {
+    mpz_class result = 0;
+    for (size_t i = f.size(); i-- > 0;) {
+        result = result * x + f[i];
+        mpz_mod(result.get_mpz_t(), result.get_mpz_t(), M.get_mpz_t());
+    }
+    return result;
+}
+
+} // namespace
+
+std::vector<mpz_class> integer_roots(const Polynomial& f, const mpz_class& bound) {
+    if (degree(f) < 0) {
+        throw std::invalid_argument("The zero polynomial has every integer as a root");
+    }
+    std::vector<mpz_class> roots;
+    if (degree(f) == 0 || bound < 0) return roots;
+
+    Polynomial s = primitive_part(trimmed(f));
+
+    // A prime keeping s squarefree mod p with its full degree. Finding one
+    // proves s squarefree; Coppersmith outputs nearly always are, so the
+    // expensive gcd over ℤ is only computed when a few primes all fail.
+    const unsigned long quick_primes = 32;
+    unsigned long p = 2;
+    ModPoly s_p;
+    auto squarefree_mod = [&](unsigned long q) {
+        size_t d = s.size() - 1;
+        if (mpz_fdiv_ui(s[d].get_mpz_t(), q) == 0) return false;
+        s_p.resize(d + 1);
+        ModPoly ds_p(d);
+        for (size_t i = 0; i <= d; ++i) {
+            s_p[i] = mpz_fdiv_ui(s[i].get_mpz_t(), q);
+        }
+        for (size_t i = 1; i <= d; ++i) {
+            ds_p[i-1] = mul_mod(s_p[i], i % q, q);
+        }
+        return gcd_mod(s_p, ds_p, q).size() == 1;
+    };
+    for (unsigned long tried = 0;; ++p) {
+        if (!is_prime(p)) continue;
+        if (squarefree_mod(p)) break;
+        if (++tried == quick_primes) {
+            // Distinct roots of f are the roots of its squarefree part
+            Polynomial g = poly_gcd(s, poly_derivative(s));
+            if (g.size() > 1) s = poly_divexact(s, g);
+            if (s.size() == 1) return roots;
+            for (p = 2; !is_prime(p) || !squarefree_mod(p); ++p) {}
+            break;
+        }
+    }
+
+    // Lift to p^k > 2·bound, so each root is fixed by its residue
+    mpz_class M = p;
+    mpz_class limit = 2 * bound;
+    std::vector<mpz_class> lifted;
+    for (unsigned long r = 0; r < p; ++r) {
+        if (eval_mod(s_p, r, p) == 0) lifted.push_back(r);
+    }
+    Polynomial ds = poly_derivative(s);
+    while (M <= limit && !lifted.empty()) {
+        M *= M;
+        Polynomial s_M = reduce_mod(s, M);
+        Polynomial ds_M = reduce_mod(ds, M);
+        for (auto& x : lifted) {
+            // x ← x − s(x)/s'(x) mod M; s'(x) is a unit since the root is simple mod p
+            mpz_class inv;
+            mpz_class slope = eval_mod(ds_M, x, M);
+            mpz_invert(inv.get_mpz_t(), slope.get_mpz_t(), M.get_mpz_t());
+            x -= eval_mod(s_M, x, M) * inv;
+            mpz_mod(x.get_mpz_t(), x.get_mpz_t(), M.get_mpz_t());
+        }
+    }
+
+    for (auto& x : lifted) {
+        if (2 * x > M) x -= M;   // symmetric residue
+        if (abs(x) <= bound && poly_eval(s, x) == 0) {
+            roots.push_back(x);
+        }
+    }
+    std::sort(roots.begin(), roots.end());
+    return roots;
+}
+
+// ─── Howgrave-Graham Lattice ─────────────────────────────────────────────
+
+IntMatrix howgrave_graham_lattice(const Polynomial& f, const mpz_class& N,
+                                  size_t m, size_t t) {
+    long deg = degree(f);
+    if (deg < 1 || f[deg] != 1) {
+        throw std::invalid_argument("Polynomial must be monic of degree at least 1");
+    }
+    if (m == 0) {
+        throw std::invalid_argument("Multiplicity m must be at least 1");
+    }
+    size_t d = static_cast<size_t>(deg);
+    size_t n = d * m + t;
+    IntMatrix B(n, n, mpz_class(0));
+
+    // Row r = i·d + j holds x^j·N^(m−i)·f^i, of degree exactly r
+    Polynomial f_pow{1};
+    for (size_t i = 0; i <= m; ++i) {
+        mpz_class scale;
+        mpz_pow_ui(scale.get_mpz_t(), N.get_mpz_t(), m - i);
+        size_t shifts = (i < m) ? d : t;
+        for (size_t j = 0; j < shifts; ++j) {
+            size_t r = i * d + j;
+            for (size_t e = 0; e < f_pow.size(); ++e) {
+                B[r][n - 1 - (e + j)] = scale * f_pow[e];
+            }
+        }
+        if (i < m) f_pow = poly_mul(f_pow, Polynomial(f.begin(), f.begin() + deg + 1));
+    }
+    return B;
+}
+
+namespace {
+
+// log2 of a positive integer, accurate to double precision
+double log2_mpz(const mpz_class& z) {
+    long exp;
+    double mant = mpz_get_d_2exp(&exp, z.get_mpz_t());
+    return std::log2(mant) + static_cast<double>(exp);
+}
+
+// f scaled by the inverse of its leading coefficient modulo N
+Polynomial make_monic(const Polynomial& f, const mpz_class& N) {
+    long deg = degree(f);
+    if (deg < 1) {
+        throw std::invalid_argument("Polynomial must have degree at least 1");
+    }
+    Polynomial g(f.begin(), f.begin() + deg + 1);
+    if (g[deg] == 1) return g;
+
+    mpz_class inv;
+    if (!mpz_invert(inv.get_mpz_t(), g[deg].get_mpz_t(), N.get_mpz_t())) {
+        throw std::invalid_argument("Leading coefficient is not invertible modulo N");
+    }
+    for (auto& c : g) {
+        c = c * inv;
+        mpz_mod(c.get_mpz_t(), c.get_mpz_t(), N.get_mpz_t());
+    }
+    g[deg] = 1;
+    return g;
+}
+
+} // namespace
+
+std::vector<Polynomial> coppersmith_candidates(const Polynomial& f, const mpz_class& N,
+                                               const mpz_class& X,
+                                               const CoppersmithParams& params) {
+    if (N < 2 || X < 1) {
+        throw std::invalid_argument("Need N ≥ 2 and X ≥ 1");
+    }
+    if (params.beta <= 0 || params.beta > 1) {
+        throw std::invalid_argument("beta must lie in (0, 1]");
+    }
+    Polynomial g = make_monic(f, N);
+    size_t d = static_cast<size_t>(degree(g));
+
+    size_t m = params.m;
+    size_t t = params.t;
+    if (m == 0) {
+        // X = N^(β²/d − ε) needs m ≈ β²/(d·ε) for the bound to be met
+        double beta = params.beta.get_d();
+        double eps = beta * beta / d - log2_mpz(X) / log2_mpz(N);
+        if (eps <= 0) {
+            throw std::invalid_argument("X is above N^(β²/d); no lattice can find such roots");
+        }
+        auto shifts = [&](size_t mm) {
+            return static_cast<size_t>(std::floor(d * mm * (1.0 / beta - 1.0)));
+        };
+        m = std::max<size_t>(1, static_cast<size_t>(std::ceil(beta * beta / (d * eps))));
+        while (m > 1 && d * m + shifts(m) > params.max_dim) --m;
+        t = shifts(m);
+        if (d * m + t > params.max_dim) {
+            if (d > params.max_dim) {
+                throw std::invalid_argument("Polynomial degree exceeds max_dim");
+            }
+            t = params.max_dim - d * m;
+        }
+    }
+
+    IntMatrix B = howgrave_graham_lattice(g, N, m, t);
+    size_t n = B.rows();
+
+    // Scale column c by X^(n−1−c) and reduce the integer lattice
+    std::vector<mpz_class> weights = coppersmith_weights(n, X);
+    IntMatrix R = lll_fp(scale_columns(B, weights), params.delta);
+
+    // Howgrave-Graham: ||h(xX)||² < (b^m)²/n ensures h(x0) = 0 over ℤ
+    mpz_class modulus;
+    mpz_pow_ui(modulus.get_mpz_t(), N.get_mpz_t(), m);
+    Rational bound = howgrave_graham_bound(modulus, params.beta, n);
+
+    auto to_poly = [&](size_t r) {
+        std::vector<mpz_class> v = unscale(R[r], weights);
+        Polynomial h(v.rbegin(), v.rend());
+        h.resize(degree(h) + 1);
+        return h;
+    };
+
+    std::vector<Polynomial> candidates;
+    for (size_t r = 0; r < n; ++r) {
+        if (Rational(dot(R[r], R[r])) < bound) {
+            candidates.push_back(to_poly(r));
+        }
+    }
+    if (candidates.empty()) {
+        candidates.push_back(to_poly(0));
+    }
+    return candidates;
+}
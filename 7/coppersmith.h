@@ -0,0 +1,120 @@
+#ifndef COPPERSMITH_H
+#define COPPERSMITH_H
+
+#include <vector>
+#include <gmpxx.h>
+#include "llllib.h"
+
+// Univariate polynomial over ℤ, coefficients from x^0 up to the leading one
+using Polynomial = std::vector<mpz_class>;
+
+// ─── Polynomial Helpers ──────────────────────────────────────────────────
+
+/**
+ * Degree of f (trailing zero coefficients ignored); −1 for the zero polynomial.
+ */
+long degree(const Polynomial& f);
+
+/**
+ * Product of two polynomials.
+ */
+Polynomial poly_mul(const Polynomial& f, const Polynomial& g);
+
+/**
+ * f(x) evaluated exactly with Horner's rule.
+ */
+mpz_class poly_eval(const Polynomial& f, const mpz_class& x);
+
+/**
+ * Derivative of f.
+ */
+Polynomial poly_derivative(const Polynomial& f);
+
+/**
+ * Greatest common divisor over ℤ, primitive with a positive leading
+ * coefficient. Computed modulo word-size primes and combined by CRT up
+ * to Mignotte's coefficient bound, then verified by exact division, so
+ * coefficient growth of a remainder sequence over ℤ is avoided.
+ */
+Polynomial poly_gcd(const Polynomial& f, const Polynomial& g);
+
+// ─── Integer Roots ───────────────────────────────────────────────────────
+
+/**
+ * All integer roots x of f with |x| ≤ bound, sorted and without
+ * repetition. A small prime p is chosen so that f mod p is squarefree of
+ * full degree (if none of the first few primes works, f is replaced by
+ * its squarefree part f / gcd(f, f') first). The roots mod p are found by
+ * exhaustive search, and each is lifted by Newton–Hensel iteration until
+ * p^k > 2·bound. Every lifted value in range is verified by exact
+ * evaluation, so no root is missed and none is reported falsely. For a
+ * squarefree f the cost is a few evaluations modulo p^k, so huge
+ * coefficients and degrees around 60 stay cheap; repeated factors add one
+ * modular poly_gcd.
+ *
+ * @param f Non-zero polynomial over ℤ.
+ * @param bound Only roots with |x| ≤ bound are returned.
+ * @return The integer roots, ascending.
+ */
+std::vector<mpz_class> integer_roots(const Polynomial& f, const mpz_class& bound);
+
+// ─── Howgrave-Graham Lattice ─────────────────────────────────────────────
+
+/**
+ * Build the Howgrave-Graham lattice for a monic f of degree d modulo an
+ * unknown divisor b of N. The rows are the coefficient vectors of
+ *     g_ij(x) = x^j · N^(m−i) · f(x)^i    0 ≤ i < m, 0 ≤ j < d
+ *     h_j(x)  = x^j · f(x)^m              0 ≤ j < t
+ * which all vanish modulo b^m at every root of f mod b. Row r has degree
+ * r, and columns hold the highest degree first (column c is the
+ * coefficient of x^(n−1−c), n = d·m + t), so lll(B, X) applies exactly
+ * the Coppersmith scaling diag(X^(n−1), ..., X, 1). In this layout row r
+ * is non-zero only in its last r + 1 columns: the basis is triangular
+ * about the anti-diagonal, which carries the leading coefficients.
+ *
+ * @param f Monic polynomial of degree d ≥ 1.
+ * @param N Modulus with an unknown divisor b ≥ N^β.
+ * @param m Multiplicity (≥ 1).
+ * @param t Number of extra shifts of f^m.
+ * @return (d·m + t)×(d·m + t) integer basis, anti-triangular as above.
+ */
+IntMatrix howgrave_graham_lattice(const Polynomial& f, const mpz_class& N,
+                                  size_t m, size_t t);
+
+/**
+ * Parameters of coppersmith_candidates.
+ *
+ * With m = 0 the multiplicity and shifts follow the usual choice for a
+ * root bound X = N^(β²/d − ε):  m = ⌈β²/(d·ε)⌉ and t = ⌊d·m·(1/β − 1)⌋,
+ * reduced as far as needed to stay within max_dim.
+ */
+struct CoppersmithParams {
+    Rational beta = Rational(1, 2);   // divisor size b ≥ N^β (1 = N itself)
+    size_t m = 0;                     // multiplicity, 0 = automatic
+    size_t t = 0;                     // shifts of f^m, used when m is given
+    size_t max_dim = 40;              // cap for the automatic choice
+    Rational delta = Rational(9999, 10000);
+};
+
+/**
+ * Small-root candidates for f(x) ≡ 0 mod b, b | N, b ≥ N^β, |x| < X.
+ * Builds the Howgrave-Graham lattice, reduces it with the L² engine on
+ * the X-scaled basis (coppersmith_weights and scale_columns, as lll(B, X)
+ * does) and turns the reduced rows back into polynomials with the checked
+ * unscale. Every row shorter than the Howgrave-Graham bound (N^(βm))/√dim is
+ * returned, and those polynomials have all such small roots over ℤ. If
+ * no row meets the bound the shortest one is still returned so callers
+ * can try it.
+ *
+ * @param f Polynomial of degree ≥ 1; made monic modulo N if needed.
+ * @param N Modulus.
+ * @param X Bound on the absolute value of the wanted roots.
+ * @param params β, multiplicity, shifts and the Lovász parameter.
+ * @return Candidate polynomials in reduced-basis order (the first one is
+ *         the shortest vector LLL found).
+ */
+std::vector<Polynomial> coppersmith_candidates(const Polynomial& f, const mpz_class& N,
+                                               const mpz_class& X,
+                                               const CoppersmithParams& params = CoppersmithParams());
+
+#endif // COPPERSMITH_H
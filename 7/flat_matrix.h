@@ -0,0 +1,112 @@
+#ifndef FLAT_MATRIX_H
+#define FLAT_MATRIX_H
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <stdexcept>
+#include <initializer_list>
+#include <type_traits>
+
+// ─── Row View ────────────────────────────────────────────────────────────
+
+/**
+ * Non-owning view of one contiguous row (or of a whole std::vector).
+ * Cheap to copy; indexing writes straight into the owning storage.
+ */
+template <typename T>
+class RowView {
+public:
+    RowView(T* data, size_t size) : data_(data), size_(size) {}
+
+    // A std::vector can be viewed as a row of matching constness
+    template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+    RowView(const std::vector<U>& v) : data_(v.data()), size_(v.size()) {}
+    template <typename U, typename = std::enable_if_t<std::is_same_v<U, T>>>
+    RowView(std::vector<U>& v) : data_(v.data()), size_(v.size()) {}
+
+    // A mutable view converts to a read-only one
+    operator RowView<const T>() const { return {data_, size_}; }
+
+    size_t size() const { return size_; }
+    T* data() const { return data_; }
+    T& operator[](size_t i) const { return data_[i]; }
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+// ─── Flat Matrix ─────────────────────────────────────────────────────────
+
+/**
+ * Row-major matrix stored in a single contiguous buffer.
+ *
+ * Move-only: a deep copy has to be requested explicitly with clone(),
+ * so reductions can never copy GSO data by accident.
+ */
+template <typename T>
+class FlatMatrix {
+public:
+    FlatMatrix() = default;
+
+    FlatMatrix(size_t rows, size_t cols, const T& value = T())
+        : rows_(rows), cols_(cols), data_(rows * cols, value) {}
+
+    FlatMatrix(std::initializer_list<std::initializer_list<T>> rows)
+        : rows_(rows.size()), cols_(rows.size() ? rows.begin()->size() : 0) {
+        data_.reserve(rows_ * cols_);
+        for (const auto& row : rows) {
+            if (row.size() != cols_) {
+                throw std::invalid_argument("Matrix rows must have the same length");
+            }
+            data_.insert(data_.end(), row.begin(), row.end());
+        }
+    }
+
+    FlatMatrix(const FlatMatrix&) = delete;
+    FlatMatrix& operator=(const FlatMatrix&) = delete;
+    FlatMatrix(FlatMatrix&&) noexcept = default;
+    FlatMatrix& operator=(FlatMatrix&&) noexcept = default;
+
+    FlatMatrix clone() const {
+        FlatMatrix copy;
+        copy.rows_ = rows_;
+        copy.cols_ = cols_;
+        copy.data_ = data_;
+        return copy;
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t size() const { return rows_; }
+    bool empty() const { return rows_ == 0; }
+
+    RowView<T> operator[](size_t i) { return {data_.data() + i * cols_, cols_}; }
+    RowView<const T> operator[](size_t i) const { return {data_.data() + i * cols_, cols_}; }
+
+    T* data() { return data_.data(); }
+    const T* data() const { return data_.data(); }
+
+    /**
+     * Swap two rows element by element (O(1) per GMP element).
+     */
+    void swap_rows(size_t i, size_t j) {
+        if (i == j) return;
+        T* a = data_.data() + i * cols_;
+        T* b = data_.data() + j * cols_;
+        for (size_t c = 0; c < cols_; ++c) {
+            using std::swap;
+            swap(a[c], b[c]);
+        }
+    }
+
+private:
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    std::vector<T> data_;
+};
+
+#endif // FLAT_MATRIX_H
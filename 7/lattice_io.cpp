@@ -0,0 +1,295 @@
+#include "lattice_io.h"
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ─── Binary Tables ───────────────────────────────────────────────────────
+
+namespace {
+
+const char table_magic[8] = {'L', 'L', 'L', 'T', 'A', 'B', 'L', 'E'};
+const uint32_t table_version = 1;
+const uint64_t byte_order_mark = 0x0102030405060708ULL;
+
+size_t word_count(const mpz_class& x) {
+    return x == 0 ? 0 : (mpz_sizeinbase(x.get_mpz_t(), 2) + 63) / 64;
+}
+
+// value(i, j) returns the entry, or nullptr for an absent one
+void write_table(const std::string& path, TableKind kind, size_t rows, size_t cols,
+                 const std::function<const mpz_class*(size_t, size_t)>& value) {
+    // The index and the running word offset must fit their on-disk fields
+    if (cols != 0 && rows > (UINT64_MAX - sizeof(TableHeader)) / sizeof(TableEntry) / cols) {
+        throw std::runtime_error("Table too large: " + path);
+    }
+    std::vector<TableEntry> index(rows * cols);
+    uint64_t words = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            TableEntry& e = index[i * cols + j];
+            const mpz_class* x = value(i, j);
+            size_t count = x ? word_count(*x) : 0;
+            if (count > UINT32_MAX || count > UINT64_MAX / sizeof(uint64_t) - words) {
+                throw std::runtime_error("Table entry too large: " + path);
+            }
+            e.offset = words;
+            e.words = static_cast<uint32_t>(count);
+            e.flags = x ? (sgn(*x) < 0 ? TABLE_NEGATIVE : 0) : TABLE_ABSENT;
+            words += count;
+        }
+    }
+
+    TableHeader header;
+    std::memcpy(header.magic, table_magic, sizeof(table_magic));
+    header.version = table_version;
+    header.kind = static_cast<uint32_t>(kind);
+    header.byte_order = byte_order_mark;
+    header.rows = rows;
+    header.cols = cols;
+    header.index_offset = sizeof(TableHeader);
+    header.data_offset = header.index_offset + index.size() * sizeof(TableEntry);
+    header.data_words = words;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Could not open file for writing: " + path);
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(TableEntry));
+
+    std::vector<uint64_t> buffer;
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            const mpz_class* x = value(i, j);
+            size_t count = x ? word_count(*x) : 0;
+            if (count == 0) continue;
+            buffer.resize(count);
+            mpz_export(buffer.data(), &count, -1, sizeof(uint64_t), 0, 0, x->get_mpz_t());
+            out.write(reinterpret_cast<const char*>(buffer.data()), count * sizeof(uint64_t));
+        }
+    }
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Could not write file: " + path);
+    }
+}
+
+} // namespace
+
+MappedTable::MappedTable(const std::string& path) : path_(path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(TableHeader)) {
+        close(fd);
+        throw std::runtime_error("Not a table file: " + path);
+    }
+    size_ = st.st_size;
+    map_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map_ == MAP_FAILED) {
+        map_ = nullptr;
+        throw std::runtime_error("Could not map file: " + path);
+    }
+
+    const unsigned char* base = static_cast<const unsigned char*>(map_);
+    header_ = reinterpret_cast<const TableHeader*>(base);
+    std::string error;
+    if (std::memcmp(header_->magic, table_magic, sizeof(table_magic)) != 0) {
+        error = "Not a table file: ";
+    } else if (header_->version != table_version) {
+        error = "Unsupported table version in ";
+    } else if (header_->byte_order != byte_order_mark) {
+        error = "Table was written with a different byte order: ";
+    } else if (header_->index_offset % 8 != 0 || header_->data_offset % 8 != 0
+               || header_->index_offset < sizeof(TableHeader)
+               || header_->index_offset > header_->data_offset
+               || header_->data_offset > size_
+               || header_->data_words > (size_ - header_->data_offset) / sizeof(uint64_t)) {
+        error = "Truncated or corrupt table file: ";
+    } else if (header_->cols != 0 && header_->rows > (header_->data_offset - header_->index_offset)
+                                                     / sizeof(TableEntry) / header_->cols) {
+        // Offsets are ordered above, so the index space is a plain difference
+        error = "Corrupt table header in ";
+    }
+    if (!error.empty()) {
+        munmap(map_, size_);
+        throw std::runtime_error(error + path);
+    }
+    index_ = reinterpret_cast<const TableEntry*>(base + header_->index_offset);
+    data_ = reinterpret_cast<const uint64_t*>(base + header_->data_offset);
+}
+
+MappedTable::~MappedTable() {
+    if (map_) munmap(map_, size_);
+}
+
+const TableEntry& MappedTable::entry(size_t i, size_t j) const {
+    if (i >= rows() || j >= cols()) {
+        throw std::out_of_range("Table index out of range");
+    }
+    return index_[i * cols() + j];
+}
+
+bool MappedTable::has(size_t i, size_t j) const {
+    return !(entry(i, j).flags & TABLE_ABSENT);
+}
+
+void MappedTable::get(size_t i, size_t j, mpz_class& x) const {
+    const TableEntry& e = entry(i, j);
+    if (e.offset > header_->data_words || e.words > header_->data_words - e.offset) {
+        throw std::runtime_error("Corrupt table entry in " + path_);
+    }
+    mpz_import(x.get_mpz_t(), e.words, -1, sizeof(uint64_t), 0, 0, data_ + e.offset);
+    if (e.flags & TABLE_NEGATIVE) {
+        mpz_neg(x.get_mpz_t(), x.get_mpz_t());
+    }
+}
+
+bool is_table_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(table_magic)];
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, table_magic, sizeof(magic)) == 0;
+}
+
+void write_matrix_file(const std::string& path, const IntMatrix& B) {
+    write_table(path, TableKind::Matrix, B.rows(), B.cols(),
+                [&](size_t i, size_t j) { return &B[i][j]; });
+}
+
+IntMatrix read_matrix_file(const std::string& path) {
+    MappedTable table(path);
+    if (table.kind() != TableKind::Matrix) {
+        throw std::runtime_error("Not a matrix table: " + path);
+    }
+    IntMatrix B(table.rows(), table.cols());
+    for (size_t i = 0; i < B.rows(); ++i) {
+        for (size_t j = 0; j < B.cols(); ++j) {
+            table.get(i, j, B[i][j]);
+        }
+    }
+    return B;
+}
+
+void write_record_file(const std::string& path, const std::vector<RSARecord>& records) {
+    write_table(path, TableKind::Records, records.size(), 5,
+                [&](size_t i, size_t j) -> const mpz_class* {
+                    const RSARecord& r = records[i];
+                    switch (j) {
+                        case 0: return &r.n;
+                        case 1: return &r.d;
+                        case 2: return &r.p0;
+                        case 3: return &r.X;
+                        default: return r.has_ciphertext ? &r.c : nullptr;
+                    }
+                });
+}
+
+RSARecord read_record(const MappedTable& table, size_t i) {
+    if (table.kind() != TableKind::Records || table.cols() != 5) {
+        throw std::runtime_error("Not a records table");
+    }
+    RSARecord record;
+    record.index = i;
+    record.line = i + 1;
+    table.get(i, 0, record.n);
+    table.get(i, 1, record.d);
+    table.get(i, 2, record.p0);
+    table.get(i, 3, record.X);
+    record.has_ciphertext = table.has(i, 4);
+    table.get(i, 4, record.c);
+    return record;
+}
+
+std::vector<RSARecord> read_record_file(const std::string& path) {
+    MappedTable table(path);
+    std::vector<RSARecord> records;
+    records.reserve(table.rows());
+    for (size_t i = 0; i < table.rows(); ++i) {
+        records.push_back(read_record(table, i));
+    }
+    return records;
+}
+
+// ─── fplll Text Format ───────────────────────────────────────────────────
+
+IntMatrix read_fplll(std::istream& in) {
+    std::vector<std::vector<mpz_class>> rows;
+    std::string token;
+    int depth = 0;
+    bool done = false;
+    char c;
+
+    auto flush_token = [&]() {
+        if (token.empty()) return;
+        if (depth != 2) {
+            throw std::runtime_error("fplll matrix: number outside a row");
+        }
+        // mpz_set_str takes a '-' but not a '+' sign
+        size_t start = token[0] == '+' ? 1 : 0;
+        mpz_class x;
+        if ((start && (token.size() == 1 || token[1] == '-'))
+            || mpz_set_str(x.get_mpz_t(), token.c_str() + start, 10) != 0) {
+            throw std::runtime_error("fplll matrix: invalid number " + token);
+        }
+        rows.back().push_back(x);
+        token.clear();
+    };
+
+    while (!done && in.get(c)) {
+        if (c == '[') {
+            flush_token();
+            if (++depth > 2) {
+                throw std::runtime_error("fplll matrix: unexpected '['");
+            }
+            if (depth == 2) rows.emplace_back();
+        } else if (c == ']') {
+            flush_token();
+            if (depth == 0) {
+                throw std::runtime_error("fplll matrix: unexpected ']'");
+            }
+            done = --depth == 0;
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            flush_token();
+        } else if (std::isdigit(static_cast<unsigned char>(c)) || c == '-' || c == '+') {
+            token.push_back(c);
+        } else {
+            throw std::runtime_error(std::string("fplll matrix: unexpected character '") + c + "'");
+        }
+    }
+    if (!done) {
+        throw std::runtime_error("fplll matrix: missing closing ']'");
+    }
+
+    size_t cols = rows.empty() ? 0 : rows[0].size();
+    IntMatrix B(rows.size(), cols);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (rows[i].size() != cols) {
+            throw std::runtime_error("fplll matrix: row " + std::to_string(i) + " has a different length");
+        }
+        for (size_t j = 0; j < cols; ++j) {
+            B[i][j] = std::move(rows[i][j]);
+        }
+    }
+    return B;
+}
+
+void write_fplll(std::ostream& out, const IntMatrix& B) {
+    out << "[";
+    for (size_t i = 0; i < B.rows(); ++i) {
+        out << "[";
+        for (size_t j = 0; j < B.cols(); ++j) {
+            out << (j ? " " : "") << B[i][j];
+        }
+        out << "]\n";
+    }
+    out << "]\n";
+}
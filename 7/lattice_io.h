@@ -0,0 +1,148 @@
+#ifndef LATTICE_IO_H
+#define LATTICE_IO_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <gmpxx.h>
+#include "llllib.h"
+#include "rsa_pipeline.h"
+
+// ─── Binary Tables ───────────────────────────────────────────────────────
+
+/*
+ * On-disk layout of a table of rows × cols big integers (all fields in
+ * native byte order, every section 8-byte aligned):
+ *
+ *     TableHeader
+ *     TableEntry[rows · cols]      row-major index of the entries
+ *     uint64_t data[data_words]    limbs of every entry, least significant first
+ *
+ * Entry values are written with mpz_export as 64-bit words, so loading one
+ * is a single mpz_import straight from the mapped file: no decimal
+ * conversion, and any entry can be read without touching the others.
+ */
+
+enum class TableKind : uint32_t {
+    Matrix = 1,      // integer lattice basis, one vector per row
+    Records = 2      // RSA instances: n, d, p0, X, c per row
+};
+
+struct TableHeader {
+    char magic[8];             // "LLLTABLE"
+    uint32_t version;
+    uint32_t kind;             // TableKind
+    uint64_t byte_order;       // 0x0102030405060708 as written by the producer
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t index_offset;     // bytes from the start of the file
+    uint64_t data_offset;
+    uint64_t data_words;
+};
+
+struct TableEntry {
+    uint64_t offset;           // first word, counted from data_offset
+    uint32_t words;            // 0 for the value 0
+    uint32_t flags;            // TABLE_NEGATIVE, TABLE_ABSENT
+};
+
+const uint32_t TABLE_NEGATIVE = 1;
+const uint32_t TABLE_ABSENT = 2;     // optional field not present (record ciphertext)
+
+/**
+ * Read-only memory mapping of a binary table. The file is validated once
+ * on open; entries are then decoded on demand.
+ */
+class MappedTable {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be mapped, is not a
+     *         table, or was written with a different byte order.
+     */
+    explicit MappedTable(const std::string& path);
+    ~MappedTable();
+
+    MappedTable(const MappedTable&) = delete;
+    MappedTable& operator=(const MappedTable&) = delete;
+
+    TableKind kind() const { return static_cast<TableKind>(header_->kind); }
+    size_t rows() const { return header_->rows; }
+    size_t cols() const { return header_->cols; }
+
+    /**
+     * False if entry (i, j) was stored as absent.
+     */
+    bool has(size_t i, size_t j) const;
+
+    /**
+     * Decode entry (i, j) into x (0 if absent).
+     * @throws std::out_of_range for an index outside the table.
+     */
+    void get(size_t i, size_t j, mpz_class& x) const;
+
+private:
+    const TableEntry& entry(size_t i, size_t j) const;
+
+    std::string path_;
+    void* map_ = nullptr;
+    size_t size_ = 0;
+    const TableHeader* header_ = nullptr;
+    const TableEntry* index_ = nullptr;
+    const uint64_t* data_ = nullptr;
+};
+
+/**
+ * True if the file starts with the table magic.
+ */
+bool is_table_file(const std::string& path);
+
+/**
+ * Write B as a TableKind::Matrix file.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void write_matrix_file(const std::string& path, const IntMatrix& B);
+
+/**
+ * Load a TableKind::Matrix file.
+ * @throws std::runtime_error if the file is not a matrix table.
+ */
+IntMatrix read_matrix_file(const std::string& path);
+
+/**
+ * Write RSA instances as a TableKind::Records file (index and line are
+ * not stored; records are numbered by their row).
+ */
+void write_record_file(const std::string& path, const std::vector<RSARecord>& records);
+
+/**
+ * Record i of a TableKind::Records table.
+ */
+RSARecord read_record(const MappedTable& table, size_t i);
+
+/**
+ * All records of a TableKind::Records file.
+ * @throws std::runtime_error if the file is not a records table.
+ */
+std::vector<RSARecord> read_record_file(const std::string& path);
+
+// ─── fplll Text Format ───────────────────────────────────────────────────
+
+/**
+ * Parse a matrix in fplll's text format, e.g.
+ *     [[1 0 3]
+ *     [0 1 5]
+ *     ]
+ * Whitespace and line breaks between entries are free, and entries may
+ * carry a '+' or '-' sign.
+ * @throws std::runtime_error on malformed input or ragged rows.
+ */
+IntMatrix read_fplll(std::istream& in);
+
+/**
+ * Write B in fplll's text format, one row per line.
+ */
+void write_fplll(std::ostream& out, const IntMatrix& B);
+
+#endif // LATTICE_IO_H
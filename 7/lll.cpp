@@ -21,7 +21,7 @@ void printRationalVector(const Vector& v, const std::string& name) {
     std::cout << "]" << std::endl;
 }
 
-void printMatrix(const std::vector<Vector>& M, const std::string& name) {
+void printMatrix(const Matrix& M, const std::string& name) {
     std::cout << name << ":" << std::endl;
     for (size_t i = 0; i < M.size(); i++) {
         std::cout << "  [";
@@ -78,7 +78,7 @@ void testFracRound() {
 void testGramSchmidt() {
     std::cout << "=== Testing Gram-Schmidt ===" << std::endl;
 
-    std::vector<Vector> B = {
+    Matrix B = {
         {Rational(3), Rational(1), Rational(0)},
         {Rational(2), Rational(2), Rational(0)},
         {Rational(0), Rational(0), Rational(1)}
@@ -111,7 +111,7 @@ void testLLL1Direct() {
     std::cout << "=== Testing lll1 (direct, no scaling) ===" << std::endl;
 
     // Simple test case
-    std::vector<Vector> B = {
+    Matrix B = {
         {Rational(1), Rational(1), Rational(1)},
         {Rational(-1), Rational(0), Rational(2)},
         {Rational(3), Rational(5), Rational(6)}
@@ -119,7 +119,7 @@ void testLLL1Direct() {
 
     printMatrix(B, "Input basis B");
 
-    auto reduced = lll1(B);
+    auto reduced = lll1(B.clone());
 
     printMatrix(reduced, "LLL-reduced basis");
 
@@ -135,15 +135,15 @@ void testLLL1Direct() {
 void testScaledLLL() {
     std::cout << "=== Testing Scaled LLL (Task 1 example) ===" << std::endl;
 
-    std::vector<std::vector<mpz_class>> M = {
+    IntMatrix M = {
         {mpz_class(52563), mpz_class(52456), mpz_class(71853)},
         {mpz_class(43532), mpz_class(76933), mpz_class(35257)},
         {mpz_class(36923), mpz_class(37276), mpz_class(42678)}
     };
 
     std::cout << "Input matrix M:" << std::endl;
-    for (const auto& row : M) {
-        std::cout << "  [" << row[0] << ", " << row[1] << ", " << row[2] << "]" << std::endl;
+    for (size_t i = 0; i < M.rows(); i++) {
+        std::cout << "  [" << M[i][0] << ", " << M[i][1] << ", " << M[i][2] << "]" << std::endl;
     }
 
     // Test without scaling first (X=1)
@@ -159,7 +159,7 @@ void testScaledLLL() {
 
     std::cout << "Scaling factors: X^2 = " << X2 << ", X = " << X << ", 1 = 1" << std::endl;
 
-    std::vector<Vector> scaled(3, Vector(3));
+    Matrix scaled(3, 3);
     for (int i = 0; i < 3; ++i) {
         scaled[i][0] = Rational(X2 * M[i][0]);
         scaled[i][1] = Rational(X * M[i][1]);
@@ -169,11 +169,11 @@ void testScaledLLL() {
     printMatrix(scaled, "Scaled matrix");
 
     std::cout << "\nRunning LLL on scaled matrix..." << std::endl;
-    auto reduced = lll1(scaled);
+    auto reduced = lll1(std::move(scaled));
     printMatrix(reduced, "LLL reduced (scaled)");
 
     std::cout << "\nUnscaling first vector..." << std::endl;
-    Vector v0 = reduced[0];
+    ConstRow v0 = reduced[0];
     Rational temp0 = v0[0] / Rational(X2);
     Rational temp1 = v0[1] / Rational(X);
     Rational temp2 = v0[2];
@@ -0,0 +1,381 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sys/resource.h>
+#include <gmpxx.h>
+#include "llllib.h"
+#include "lattice_io.h"
+
+// Benchmark for the reduction engine. Every lattice family is generated
+// from a fixed seed, so runs are reproducible across machines and builds.
+//
+// Usage: lll_bench [--family knapsack|gm|coppersmith|all] [--dim n]
+//                  [--bits b] [--reps r] [--seed s] [--threads t]
+//                  [--stats json] [--input file] [--export prefix]
+//
+// --threads t (t > 1) also times lll1_parallel, and runs lll_segment, with
+// t threads.
+// --stats json prints the full LLLStats of the last lll1 run per family.
+// --input benchmarks a lattice from a binary matrix table or an fplll text
+// file instead of the generated families.
+// --export writes every generated lattice to <prefix>-<family>.txt in
+// fplll format and <prefix>-<family>.bin as a binary table.
+
+// ─── GMP Allocation Tracking ─────────────────────────────────────────────
+
+// lll1_parallel and lll_segment allocate from several threads at once, so
+// every counter is atomic and the peak is raised with a compare-and-swap.
+static std::atomic<size_t> g_live_bytes{0};
+static std::atomic<size_t> g_peak_bytes{0};
+static std::atomic<size_t> g_allocations{0};
+
+static void raise_peak(size_t live) {
+    size_t peak = g_peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !g_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+static void* track_alloc(size_t size) {
+    raise_peak(g_live_bytes.fetch_add(size, std::memory_order_relaxed) + size);
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size);
+}
+
+static void* track_realloc(void* ptr, size_t old_size, size_t new_size) {
+    if (new_size >= old_size) {
+        size_t grow = new_size - old_size;
+        raise_peak(g_live_bytes.fetch_add(grow, std::memory_order_relaxed) + grow);
+    } else {
+        g_live_bytes.fetch_sub(old_size - new_size, std::memory_order_relaxed);
+    }
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::realloc(ptr, new_size);
+}
+
+static void track_free(void* ptr, size_t size) {
+    g_live_bytes.fetch_sub(size, std::memory_order_relaxed);
+    std::free(ptr);
+}
+
+// ─── Lattice Generators ──────────────────────────────────────────────────
+
+struct Lattice {
+    std::string family;
+    IntMatrix basis;
+    std::vector<mpz_class> weights;   // column scaling for lll()
+    mpz_class X;                      // Coppersmith bound (coppersmith family only)
+};
+
+// Knapsack-type: n × (n+1), row i = [a_i, e_i] with random bits-bit a_i
+static Lattice knapsack_lattice(gmp_randclass& rng, size_t n, size_t bits) {
+    Lattice L{"knapsack", IntMatrix(n, n + 1), std::vector<mpz_class>(n + 1, 1), 1};
+    for (size_t i = 0; i < n; ++i) {
+        L.basis[i][0] = rng.get_z_bits(bits);
+        L.basis[i][i + 1] = 1;
+    }
+    return L;
+}
+
+// Goldstein–Mayer: [[p, 0, ...], [x_i, e_i]] with a bits-bit prime p, x_i < p
+static Lattice goldstein_mayer_lattice(gmp_randclass& rng, size_t n, size_t bits) {
+    Lattice L{"gm", IntMatrix(n, n), std::vector<mpz_class>(n, 1), 1};
+    mpz_class p = rng.get_z_bits(bits);
+    mpz_setbit(p.get_mpz_t(), bits - 1);
+    mpz_nextprime(p.get_mpz_t(), p.get_mpz_t());
+    L.basis[0][0] = p;
+    for (size_t i = 1; i < n; ++i) {
+        L.basis[i][0] = rng.get_z_range(p);
+        L.basis[i][i] = 1;
+    }
+    return L;
+}
+
+// Coppersmith-shaped: rows N^(n-1-i)·(x + p0)^i for i < n, highest-degree
+// coefficient first as in main.cpp, with N of bits bits and X ≈ N^(1/8)
+static Lattice coppersmith_lattice(gmp_randclass& rng, size_t n, size_t bits) {
+    Lattice L{"coppersmith", IntMatrix(n, n), {}, 0};
+    mpz_class N = rng.get_z_bits(bits);
+    mpz_setbit(N.get_mpz_t(), bits - 1);
+    mpz_class p0 = rng.get_z_bits(bits / 2);
+    L.X = mpz_class(1) << (bits / 8);
+
+    std::vector<mpz_class> f_pow{1};   // coefficients of (x + p0)^i, low → high
+    for (size_t i = 0; i < n; ++i) {
+        mpz_class scale;
+        mpz_pow_ui(scale.get_mpz_t(), N.get_mpz_t(), n - 1 - i);
+        for (size_t d = 0; d < f_pow.size(); ++d) {
+            L.basis[i][n - 1 - d] = scale * f_pow[d];
+        }
+        std::vector<mpz_class> next(f_pow.size() + 1, 0);
+        for (size_t d = 0; d < f_pow.size(); ++d) {
+            next[d] += p0 * f_pow[d];
+            next[d + 1] += f_pow[d];
+        }
+        f_pow = std::move(next);
+    }
+
+    L.weights.resize(n);
+    mpz_class power = 1;
+    for (size_t j = n; j-- > 0;) {
+        L.weights[j] = power;
+        power *= L.X;
+    }
+    return L;
+}
+
+// Lattice from a binary matrix table or an fplll text file, unit weights
+static Lattice load_lattice(const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+    IntMatrix basis;
+    if (is_table_file(path)) {
+        basis = read_matrix_file(path);
+    } else {
+        std::ifstream in(path);
+        if (!in) {
+            throw std::runtime_error("Could not open file: " + path);
+        }
+        basis = read_fplll(in);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "loaded " << path << " (" << basis.rows() << " x " << basis.cols() << ") in "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    Lattice L{"file", std::move(basis), {}, 1};
+    L.weights.assign(L.basis.cols(), 1);
+    return L;
+}
+
+// ─── Timing ──────────────────────────────────────────────────────────────
+
+struct Sample {
+    double ms;
+    LLLStats stats;
+    size_t peak_bytes;
+    size_t allocations;
+};
+
+static Sample run_once(const std::function<void(LLLStats&)>& body) {
+    LLLStats stats;
+    size_t live_before = g_live_bytes.load();
+    size_t allocations_before = g_allocations.load();
+    g_peak_bytes.store(live_before);
+
+    auto start = std::chrono::steady_clock::now();
+    body(stats);
+    auto end = std::chrono::steady_clock::now();
+
+    return {std::chrono::duration<double, std::milli>(end - start).count(),
+            stats,
+            g_peak_bytes.load() - live_before,
+            g_allocations.load() - allocations_before};
+}
+
+static double percentile(std::vector<double> v, double p) {
+    std::sort(v.begin(), v.end());
+    size_t idx = static_cast<size_t>(p * (v.size() - 1) + 0.5);
+    return v[idx];
+}
+
+static void report(const Lattice& L, const std::string& op, const std::vector<Sample>& samples) {
+    std::vector<double> times;
+    size_t peak = 0;
+    for (const auto& s : samples) {
+        times.push_back(s.ms);
+        peak = std::max(peak, s.peak_bytes);
+    }
+    std::cout << std::left << std::setw(12) << L.family
+              << std::right << std::setw(5) << L.basis.rows()
+              << std::setw(15) << op
+              << std::setw(12) << std::fixed << std::setprecision(3) << percentile(times, 0.5)
+              << std::setw(12) << percentile(times, 0.95)
+              << std::setw(10) << samples.back().stats.swaps
+              << std::setw(12) << samples.back().allocations
+              << std::setw(12) << peak / 1024 << "\n";
+}
+
+static Matrix to_rational(const IntMatrix& B, const std::vector<mpz_class>& weights) {
+    Matrix R(B.rows(), B.cols());
+    for (size_t i = 0; i < B.rows(); ++i) {
+        for (size_t j = 0; j < B.cols(); ++j) {
+            R[i][j] = Rational(weights[j] * B[i][j]);
+        }
+    }
+    return R;
+}
+
+static void bench(const Lattice& L, size_t reps, size_t threads, bool json) {
+    Matrix scaled = to_rational(L.basis, L.weights);
+    std::vector<Sample> gs, reduce, parallel, segment, scaled_lll;
+
+    for (size_t r = 0; r < reps; ++r) {
+        gs.push_back(run_once([&](LLLStats&) { gram_schmidt(scaled); }));
+        reduce.push_back(run_once([&](LLLStats& stats) {
+            lll1(scaled.clone(), Rational(9999, 10000), &stats);
+        }));
+        if (threads > 1) {
+            parallel.push_back(run_once([&](LLLStats& stats) {
+                lll1_parallel(scaled.clone(), threads, Rational(9999, 10000), &stats);
+            }));
+        }
+        segment.push_back(run_once([&](LLLStats&) {
+            lll_segment(scaled.clone(), 0, std::max<size_t>(threads, 1));
+        }));
+        scaled_lll.push_back(run_once([&](LLLStats& stats) {
+            if (L.family == "coppersmith") {
+                lll(L.basis, L.X, Rational(9999, 10000), &stats);
+            } else {
+                lll(L.basis, L.weights, Rational(9999, 10000), &stats);
+            }
+        }));
+    }
+
+    report(L, "gram_schmidt", gs);
+    report(L, "lll1", reduce);
+    if (!parallel.empty()) report(L, "lll1_parallel", parallel);
+    report(L, "lll_segment", segment);
+    report(L, "lll", scaled_lll);
+    if (json) {
+        std::cout << "  lll1 stats: ";
+        write_stats_json(std::cout, reduce.back().stats);
+        std::cout << "\n";
+    }
+}
+
+static int usage() {
+    std::cerr << "Usage: lll_bench [--family knapsack|gm|coppersmith|all] [--dim n]\n"
+              << "                 [--bits b] [--reps r] [--seed s] [--threads t]\n"
+              << "                 [--stats json] [--input file] [--export prefix]\n";
+    return 1;
+}
+
+// Decimal digits only; std::stoul alone would accept signs, spaces and a
+// trailing suffix, and throw on anything else or on overflow
+static bool parse_number(const std::string& value, unsigned long& out) {
+    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    try {
+        out = std::stoul(value);
+    } catch (const std::out_of_range&) {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string family = "all";
+    unsigned long dim = 10;
+    unsigned long bits = 100;
+    unsigned long reps = 5;
+    unsigned long seed = 1;
+    unsigned long threads = 0;
+    bool json = false;
+    std::string input;
+    std::string export_prefix;
+
+    for (int i = 1; i < argc; i += 2) {
+        std::string flag = argv[i];
+        unsigned long* number = flag == "--dim" ? &dim
+                              : flag == "--bits" ? &bits
+                              : flag == "--reps" ? &reps
+                              : flag == "--seed" ? &seed
+                              : flag == "--threads" ? &threads
+                              : nullptr;
+        if (!number && flag != "--family" && flag != "--stats"
+            && flag != "--input" && flag != "--export") {
+            std::cerr << "Unknown option " << flag << "\n";
+            return usage();
+        }
+        if (i + 1 == argc) {
+            std::cerr << "Missing value for " << flag << "\n";
+            return usage();
+        }
+        std::string value = argv[i + 1];
+        if (number) {
+            if (!parse_number(value, *number)) {
+                std::cerr << "Invalid value for " << flag << ": " << value << "\n";
+                return usage();
+            }
+        } else if (flag == "--family") {
+            family = value;
+        } else if (flag == "--stats") {
+            if (value != "json") {
+                std::cerr << "Invalid value for " << flag << ": " << value << "\n";
+                return usage();
+            }
+            json = true;
+        } else if (flag == "--input") {
+            input = value;
+        } else {
+            export_prefix = value;
+        }
+    }
+    if (dim < 2 || bits < 8 || reps == 0) {
+        std::cerr << "Need --dim >= 2, --bits >= 8 and --reps >= 1\n";
+        return 1;
+    }
+
+    mp_set_memory_functions(track_alloc, track_realloc, track_free);
+    gmp_randclass rng(gmp_randinit_default);
+    rng.seed(seed);
+
+    std::vector<Lattice> lattices;
+    if (!input.empty()) {
+        try {
+            lattices.push_back(load_lattice(input));
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+    } else {
+        if (family == "knapsack" || family == "all") lattices.push_back(knapsack_lattice(rng, dim, bits));
+        if (family == "gm" || family == "all") lattices.push_back(goldstein_mayer_lattice(rng, dim, bits));
+        if (family == "coppersmith" || family == "all") lattices.push_back(coppersmith_lattice(rng, dim, bits));
+    }
+    if (lattices.empty()) {
+        std::cerr << "Unknown family " << family << "\n";
+        return 1;
+    }
+    if (!export_prefix.empty()) {
+        for (const auto& L : lattices) {
+            std::string base = export_prefix + "-" + L.family;
+            std::ofstream out(base + ".txt");
+            write_fplll(out, L.basis);
+            write_matrix_file(base + ".bin", L.basis);
+            std::cout << "exported " << base << ".txt and " << base << ".bin\n";
+        }
+    }
+
+    std::cout << "dim = " << dim << ", bits = " << bits << ", reps = " << reps
+              << ", seed = " << seed << "\n\n";
+    std::cout << std::left << std::setw(12) << "family"
+              << std::right << std::setw(5) << "n"
+              << std::setw(15) << "operation"
+              << std::setw(12) << "median ms"
+              << std::setw(12) << "p95 ms"
+              << std::setw(10) << "swaps"
+              << std::setw(12) << "gmp allocs"
+              << std::setw(12) << "peak KiB" << "\n";
+
+    for (const auto& L : lattices) {
+        bench(L, reps, threads, json);
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    long max_rss_kib = usage.ru_maxrss / 1024;
+#else
+    long max_rss_kib = usage.ru_maxrss;
+#endif
+    std::cout << "\nprocess peak RSS: " << max_rss_kib << " KiB\n";
+    return 0;
+}
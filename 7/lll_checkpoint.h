@@ -0,0 +1,45 @@
+#ifndef LLL_CHECKPOINT_H
+#define LLL_CHECKPOINT_H
+
+#include <chrono>
+#include "llllib.h"
+
+// Internal to llllib: periodic checkpointing for the reduction loops.
+//
+// The owner of a CheckpointWriter keeps its non-basis fields (algorithm,
+// BKZ tour position) current; the loop that owns the basis asks due() once
+// per iteration and then hands over the basis and its own loop index.
+
+class CheckpointWriter {
+public:
+    CheckpointWriter(const CheckpointParams& params, const std::string& algorithm,
+                     const Rational& delta);
+
+    bool enabled() const { return !params_.path.empty(); }
+
+    // True once the interval has passed since the last write (or the start)
+    bool due() const {
+        return enabled() && std::chrono::steady_clock::now() >= next_;
+    }
+
+    // Save B and k with the current fields of state()
+    void write(const Matrix& B, size_t k);
+
+    // Delete the checkpoint file after a finished run
+    void finish();
+
+    CheckpointState& state() { return state_; }
+
+private:
+    void schedule();
+
+    CheckpointParams params_;
+    CheckpointState state_;
+    std::chrono::steady_clock::time_point next_;
+};
+
+// The lll1 loop from index k with checkpoints (defined in llllib.cpp)
+void lll1_in_place(Matrix& B, GramSchmidtResult& gs, const Rational& delta,
+                   LLLStats* stats, CheckpointWriter& checkpoint, size_t k);
+
+#endif // LLL_CHECKPOINT_H
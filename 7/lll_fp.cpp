@@ -0,0 +1,262 @@
+#include "llllib.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// ─── Floating-Point Traits ───────────────────────────────────────────────
+
+namespace {
+
+// Thrown by the L² engine when the current precision cannot be trusted.
+// The basis is always left as a valid (exact) lattice basis, so the driver
+// can simply retry from where the engine stopped with more precision.
+struct PrecisionLoss {};
+
+template <typename FT>
+struct FloatTraits;
+
+template <>
+struct FloatTraits<double> {
+    static double from_mpz(const mpz_class& z, mp_bitcnt_t) {
+        long exp;
+        double d = mpz_get_d_2exp(&exp, z.get_mpz_t());
+        if (exp > DBL_MAX_EXP - 2) throw PrecisionLoss();
+        return std::ldexp(d, exp);
+    }
+    static double from_rational(const Rational& q, mp_bitcnt_t) { return q.get_d(); }
+    static mpz_class round(double x) {
+        if (!std::isfinite(x)) throw PrecisionLoss();
+        return mpz_class(std::round(x));
+    }
+    static bool ok(double x) { return std::isfinite(x); }
+    static double abs(double x) { return std::fabs(x); }
+};
+
+template <>
+struct FloatTraits<long double> {
+    // mpz_get_d_2exp only yields 53 bits, so take the top 64 bits by hand
+    static long double from_mpz(const mpz_class& z, mp_bitcnt_t) {
+        if (z == 0) return 0.0L;
+        size_t bits = mpz_sizeinbase(z.get_mpz_t(), 2);
+        if (bits > LDBL_MAX_EXP - 2) throw PrecisionLoss();
+        mpz_class a = ::abs(z);
+        long shift = 0;
+        if (bits > 64) {
+            shift = static_cast<long>(bits - 64);
+            mpz_tdiv_q_2exp(a.get_mpz_t(), a.get_mpz_t(), shift);
+        }
+        long double r = std::ldexp(static_cast<long double>(mpz_get_ui(a.get_mpz_t())), shift);
+        return z < 0 ? -r : r;
+    }
+    static long double from_rational(const Rational& q, mp_bitcnt_t p) {
+        return from_mpz(q.get_num(), p) / from_mpz(q.get_den(), p);
+    }
+    static mpz_class round(long double x) {
+        if (!std::isfinite(x)) throw PrecisionLoss();
+        x = std::round(x);
+        int exp;
+        long double frac = std::frexp(std::fabs(x), &exp);
+        if (exp <= 0) return 0;
+        // frac ∈ [0.5, 1): its 64 significant bits fit in an unsigned long
+        mpz_class r = static_cast<unsigned long>(std::ldexp(frac, 64));
+        if (exp >= 64) {
+            r <<= (exp - 64);
+        } else {
+            r >>= (64 - exp);
+        }
+        return x < 0 ? mpz_class(-r) : r;
+    }
+    static bool ok(long double x) { return std::isfinite(x); }
+    static long double abs(long double x) { return std::fabs(x); }
+};
+
+template <>
+struct FloatTraits<mpf_class> {
+    static mpf_class from_mpz(const mpz_class& z, mp_bitcnt_t prec) { return mpf_class(z, prec); }
+    static mpf_class from_rational(const Rational& q, mp_bitcnt_t prec) { return mpf_class(q, prec); }
+    static mpz_class round(const mpf_class& x) {
+        // Round half away from zero, matching frac_round
+        mpf_class t(::abs(x) + 0.5, x.get_prec());
+        mpz_class r(trunc(t));
+        return sgn(x) < 0 ? mpz_class(-r) : r;
+    }
+    static bool ok(const mpf_class&) { return true; }
+    static mpf_class abs(const mpf_class& x) { return ::abs(x); }
+};
+
+// ─── L² Engine ───────────────────────────────────────────────────────────
+
+/*
+ * One run of the L² algorithm (Nguyen–Stehlé) with floating type FT.
+ * The basis and its Gram matrix are exact; only the Cholesky factors
+ * r_ij and mu_ij are approximate. Throws PrecisionLoss as soon as the
+ * approximation misbehaves (non-finite values, a non-positive r_kk on an
+ * accepted row, or lazy size reduction that stops shrinking b_k).
+ */
+template <typename FT>
+void l2_run(IntMatrix& B, const Rational& delta, mp_bitcnt_t prec) {
+    using T = FloatTraits<FT>;
+    const size_t n = B.rows();
+    const FT eta = T::from_rational(Rational(51, 100), prec);
+    const FT delta_fp = T::from_rational(delta, prec);
+    const FT zero = T::from_mpz(0, prec);
+    const int max_stalled = 3;
+
+    IntMatrix G(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j <= i; ++j) {
+            G[i][j] = G[j][i] = dot(B[i], B[j]);
+        }
+    }
+
+    FlatMatrix<FT> r(n, n, zero);
+    FlatMatrix<FT> mu(n, n, zero);
+    std::vector<FT> s(n, zero);
+    r[0][0] = T::from_mpz(G[0][0], prec);
+
+    // Approximate Cholesky factorisation of row k from the exact Gram row
+    auto cholesky_row = [&](size_t k) {
+        for (size_t j = 0; j < k; ++j) {
+            r[k][j] = T::from_mpz(G[k][j], prec);
+            for (size_t l = 0; l < j; ++l) {
+                r[k][j] -= mu[j][l] * r[k][l];
+            }
+            mu[k][j] = r[k][j] / r[j][j];
+            if (!T::ok(mu[k][j])) throw PrecisionLoss();
+        }
+        s[0] = T::from_mpz(G[k][k], prec);
+        for (size_t j = 1; j <= k; ++j) {
+            s[j] = s[j-1] - mu[k][j-1] * r[k][j-1];
+        }
+        r[k][k] = s[k];
+    };
+
+    size_t k = 1;
+    while (k < n) {
+        // Lazy size reduction: repeat until every |mu_kj| ≤ eta. A single
+        // pass may grow b_k slightly, but several passes in a row that fail
+        // to shrink it mean the approximate mu are too inaccurate to use.
+        int stalled = 0;
+        for (;;) {
+            cholesky_row(k);
+
+            bool reduced = true;
+            for (size_t j = 0; j < k; ++j) {
+                if (T::abs(mu[k][j]) > eta) {
+                    reduced = false;
+                    break;
+                }
+            }
+            if (reduced) break;
+            mpz_class old_norm = G[k][k];
+
+            for (size_t jj = k; jj-- > 0;) {
+                mpz_class X = T::round(mu[k][jj]);
+                if (X == 0) continue;
+                row_submul(B[k], B[jj], X);
+                FT X_fp = T::from_mpz(X, prec);
+                for (size_t l = 0; l < jj; ++l) {
+                    mu[k][l] -= X_fp * mu[jj][l];
+                }
+            }
+
+            for (size_t i = 0; i < n; ++i) {
+                G[k][i] = G[i][k] = dot(B[k], B[i]);
+            }
+            stalled = (G[k][k] < old_norm) ? 0 : stalled + 1;
+            if (stalled > max_stalled) throw PrecisionLoss();
+        }
+        if (!T::ok(s[k-1])) throw PrecisionLoss();
+
+        // Lovász condition on the approximate GSO. A tiny true r_kk may come
+        // out non-positive through cancellation; that still means "swap",
+        // but accepting such a row would poison every later division.
+        if (delta_fp * r[k-1][k-1] <= s[k-1]) {
+            if (!(r[k][k] > zero)) throw PrecisionLoss();
+            k++;
+        } else {
+            B.swap_rows(k, k-1);
+            G.swap_rows(k, k-1);
+            for (size_t i = 0; i < n; ++i) {
+                std::swap(G[i][k], G[i][k-1]);
+            }
+            if (k == 1) {
+                r[0][0] = T::from_mpz(G[0][0], prec);
+            } else {
+                k--;
+            }
+        }
+    }
+}
+
+// Smallest precision that L² needs in dimension n (≈ 1.6·n + o(n) bits)
+mp_bitcnt_t l2_required_precision(size_t n) {
+    return static_cast<mp_bitcnt_t>(1.6 * static_cast<double>(n)) + 32;
+}
+
+} // namespace
+
+// ─── Floating-Point LLL (L²) ─────────────────────────────────────────────
+
+IntMatrix lll_fp(IntMatrix B, const Rational& delta, FloatType start) {
+    if (B.empty()) {
+        throw std::invalid_argument("Basis must contain at least one vector");
+    }
+    size_t m = B.cols();
+    size_t max_bits = 1;
+    for (size_t i = 0; i < B.rows(); ++i) {
+        for (const auto& x : B[i]) {
+            max_bits = std::max(max_bits, mpz_sizeinbase(x.get_mpz_t(), 2));
+        }
+    }
+
+    // Run the floating-point reduction with a slightly stronger delta so the
+    // exact certification pass below usually finds nothing left to do.
+    Rational delta_fp = (delta + 1) / 2;
+    size_t n = B.rows();
+    mp_bitcnt_t needed = l2_required_precision(n);
+    // Gram entries need about 2·max_bits + log2(m) bits of exponent range
+    size_t gram_bits = 2 * max_bits + mpz_sizeinbase(mpz_class(m).get_mpz_t(), 2);
+
+    int level = static_cast<int>(start);
+    if (start == FloatType::Auto) {
+        if (needed <= DBL_MANT_DIG && gram_bits < DBL_MAX_EXP - 2) {
+            level = static_cast<int>(FloatType::Double);
+        } else if (needed <= LDBL_MANT_DIG && gram_bits < LDBL_MAX_EXP - 2) {
+            level = static_cast<int>(FloatType::LongDouble);
+        } else {
+            level = static_cast<int>(FloatType::MultiPrecision);
+        }
+    }
+
+    // Escalate double → long double → mpf (doubling precision) on instability
+    mp_bitcnt_t prec = std::max<mp_bitcnt_t>(needed, 2 * LDBL_MANT_DIG);
+    const mp_bitcnt_t max_prec = std::max<mp_bitcnt_t>(64 * needed, 4096);
+    for (;;) {
+        try {
+            if (level == static_cast<int>(FloatType::Double)) {
+                l2_run<double>(B, delta_fp, DBL_MANT_DIG);
+            } else if (level == static_cast<int>(FloatType::LongDouble)) {
+                l2_run<long double>(B, delta_fp, LDBL_MANT_DIG);
+            } else {
+                l2_run<mpf_class>(B, delta_fp, prec);
+            }
+            break;
+        } catch (const PrecisionLoss&) {
+            if (level < static_cast<int>(FloatType::MultiPrecision)) {
+                level++;
+            } else if (prec < max_prec) {
+                prec *= 2;
+            } else {
+                // Give up on floating point; the exact pass finishes the job
+                break;
+            }
+        }
+    }
+
+    // Exact certification: on an already reduced basis this only computes
+    // the integral GSO once, and otherwise repairs the last few ulps of
+    // size reduction.
+    return lll1_integral(std::move(B), delta);
+}
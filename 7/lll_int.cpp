@@ -0,0 +1,216 @@
+#include "llllib.h"
+#include "lll_stats.h"
+#include <stdexcept>
+#include <algorithm>
+
+// ─── Integral LLL (de Weger / Cohen) ─────────────────────────────────────
+
+/*
+ * Notation (0-indexed): D[t] is the Gram determinant of the first t basis
+ * vectors, so D[0] = 1 and ||b*_j||² = D[j+1] / D[j]. The scaled
+ * coefficients lambda[i][j] = D[j+1] · mu[i][j] are integers. Every update
+ * below is an exact division, so no gcd normalisation ever happens.
+ */
+
+namespace {
+
+// Round lambda / d (d > 0) to the nearest integer, halves away from zero,
+// exactly as frac_round does on the corresponding Rational.
+mpz_class round_div(const mpz_class& lambda, const mpz_class& d) {
+    mpz_class t = 2 * lambda;
+    if (lambda >= 0) {
+        t += d;
+    } else {
+        t -= d;
+    }
+    mpz_class two_d = 2 * d;
+    mpz_tdiv_q(t.get_mpz_t(), t.get_mpz_t(), two_d.get_mpz_t());
+    return t;
+}
+
+void divexact(mpz_class& x, const mpz_class& d) {
+    mpz_divexact(x.get_mpz_t(), x.get_mpz_t(), d.get_mpz_t());
+}
+
+// ||b_k||² < num/den, skipping the O(m) norm while ||b*_k||² alone is too large
+bool shorter_than(const std::vector<mpz_class>& D, ConstIntRow b, size_t k,
+                  const mpz_class& num, const mpz_class& den) {
+    // ||b*_k||² = D[k+1] / D[k]
+    if (den * D[k+1] >= num * D[k]) return false;
+    return den * dot(b, b) < num;
+}
+
+/*
+ * The reduction itself. It only reads the Gram matrix G of the current
+ * basis once, to set up D and lambda, and afterwards applies every size
+ * reduction and swap to the rows of R, which hold either the basis itself
+ * or the transformation U. Its cost per step is therefore O(width of R).
+ *
+ * With a stop bound (only meaningful when R is the basis) it returns as
+ * soon as some size-reduced row is shorter than the bound, with that row's
+ * index, exactly like the rational loop; otherwise it returns n.
+ */
+size_t reduce_gram(const IntMatrix& G, IntMatrix& R, const Rational& delta,
+                   LLLStats* stats, const Rational* stop = nullptr) {
+    size_t n = G.rows();
+
+    // Integral Gram–Schmidt from the exact Gram matrix
+    std::vector<mpz_class> D(n + 1);
+    IntMatrix lambda(n, n);
+    D[0] = 1;
+    {
+        LLL_PHASE(stats, gso_seconds);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j <= i; ++j) {
+                mpz_class u = G[i][j];
+                for (size_t l = 0; l < j; ++l) {
+                    u = D[l+1] * u - lambda[i][l] * lambda[j][l];
+                    divexact(u, D[l]);
+                }
+                if (j < i) {
+                    lambda[i][j] = u;
+                } else {
+                    D[i+1] = u;
+                }
+            }
+            if (D[i+1] == 0) {
+                throw std::runtime_error("Input basis is linearly dependent.");
+            }
+            if (D[i+1] < 0) {
+                throw std::invalid_argument("Gram matrix is not positive definite");
+            }
+        }
+    }
+    LLL_STAT(stats, stats->gso_recomputations++;
+                    for (size_t i = 0; i < n; ++i) {
+                        track_bits(*stats, ConstIntRow(lambda[i].data(), i));
+                        track_bits(*stats, D[i+1]);
+                    });
+
+    const mpz_class& p = delta.get_num();
+    const mpz_class& q = delta.get_den();
+    size_t k = 1;
+    size_t found = n;
+    if (stop && shorter_than(D, R[0], 0, stop->get_num(), stop->get_den())) {
+        found = 0;
+        k = n;
+    }
+
+    while (k < n) {
+        // Size reduction, same order and rounding as lll1
+        {
+            LLL_PHASE(stats, size_reduction_seconds);
+            for (size_t j = k; j-- > 0;) {
+                mpz_class r = round_div(lambda[k][j], D[j+1]);
+                if (r == 0) continue;
+                row_submul(R[k], R[j], r);
+                mpz_submul(lambda[k][j].get_mpz_t(), r.get_mpz_t(), D[j+1].get_mpz_t());
+                row_submul(IntRow(lambda[k].data(), j), ConstIntRow(lambda[j].data(), j), r);
+                LLL_STAT(stats, stats->size_reductions++);
+            }
+            LLL_STAT(stats, track_bits(*stats, R[k]);
+                            track_bits(*stats, ConstIntRow(lambda[k].data(), k)));
+        }
+
+        if (stop && shorter_than(D, R[k], k, stop->get_num(), stop->get_den())) {
+            found = k;
+            break;
+        }
+
+        // Lovász condition multiplied through by q·D[k]·D[k-1]:
+        //   q·(D[k+1]·D[k-1] + lambda²) ≥ p·D[k]²
+        bool lovasz;
+        {
+            LLL_PHASE(stats, lovasz_seconds);
+            const mpz_class& lam = lambda[k][k-1];
+            mpz_class lhs = q * (D[k+1] * D[k-1] + lam * lam);
+            mpz_class rhs = p * D[k] * D[k];
+            lovasz = lhs >= rhs;
+            LLL_STAT(stats, stats->lovasz_tests++);
+        }
+
+        if (lovasz) {
+            k++;
+        } else {
+            {
+                LLL_PHASE(stats, swap_seconds);
+                R.swap_rows(k, k-1);
+                for (size_t j = 0; j + 1 < k; ++j) {
+                    std::swap(lambda[k][j], lambda[k-1][j]);
+                }
+                mpz_class lam_k = lambda[k][k-1];
+                mpz_class new_d = D[k-1] * D[k+1] + lam_k * lam_k;
+                divexact(new_d, D[k]);
+                for (size_t i = k + 1; i < n; ++i) {
+                    mpz_class t = lambda[i][k];
+                    lambda[i][k] = D[k+1] * lambda[i][k-1] - lam_k * t;
+                    divexact(lambda[i][k], D[k]);
+                    lambda[i][k-1] = new_d * t + lam_k * lambda[i][k];
+                    divexact(lambda[i][k-1], D[k+1]);
+                }
+                D[k] = new_d;
+                LLL_STAT(stats, stats->swaps++;
+                                track_bits(*stats, D[k]));
+            }
+            LLL_STAT(stats, trace_swap(*stats, k));
+            k = std::max((int)k - 1, 1);
+        }
+    }
+
+    LLL_STAT(stats, trace_done(*stats));
+    return found;
+}
+
+// Gram matrix B·Bᵀ
+IntMatrix gram_matrix(const IntMatrix& B) {
+    size_t n = B.rows();
+    IntMatrix G(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j <= i; ++j) {
+            G[i][j] = G[j][i] = dot(B[i], B[j]);
+        }
+    }
+    return G;
+}
+
+} // namespace
+
+IntMatrix lll1_integral(IntMatrix B, const Rational& delta, LLLStats* stats) {
+    if (B.rows() == 0) {
+        throw std::invalid_argument("Basis must contain at least one vector");
+    }
+    reduce_gram(gram_matrix(B), B, delta, stats);
+    return B;
+}
+
+size_t lll1_integral_until(IntMatrix& B, const Rational& max_normsq,
+                           const Rational& delta, LLLStats* stats) {
+    if (B.rows() == 0) {
+        throw std::invalid_argument("Basis must contain at least one vector");
+    }
+    return reduce_gram(gram_matrix(B), B, delta, stats, &max_normsq);
+}
+
+IntMatrix lll_gram(const IntMatrix& G, const Rational& delta) {
+    size_t n = G.rows();
+    if (n == 0) {
+        throw std::invalid_argument("Gram matrix must not be empty");
+    }
+    if (G.cols() != n) {
+        throw std::invalid_argument("Gram matrix must be square");
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            if (G[i][j] != G[j][i]) {
+                throw std::invalid_argument("Gram matrix must be symmetric");
+            }
+        }
+    }
+
+    IntMatrix U(n, n, mpz_class(0));
+    for (size_t i = 0; i < n; ++i) {
+        U[i][i] = 1;
+    }
+    reduce_gram(G, U, delta, nullptr);
+    return U;
+}
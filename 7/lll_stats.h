@@ -0,0 +1,85 @@
+#ifndef LLL_STATS_H
+#define LLL_STATS_H
+
+#include <chrono>
+#include <algorithm>
+#include <ostream>
+#include "llllib.h"
+
+// Internal to llllib: instrumentation hooks for the reduction loops.
+//
+// Every hook takes the (possibly null) LLLStats pointer of the current
+// call. With LLLLIB_STATS=0 they all expand to ((void)stats), so the
+// loops compile exactly as if the instrumentation had never been there.
+
+#if LLLLIB_STATS
+
+// Adds the lifetime of the enclosing scope to a phase timer
+class PhaseTimer {
+public:
+    explicit PhaseTimer(double* seconds) : seconds_(seconds) {
+        if (seconds_) start_ = std::chrono::steady_clock::now();
+    }
+    ~PhaseTimer() {
+        if (seconds_) {
+            auto end = std::chrono::steady_clock::now();
+            *seconds_ += std::chrono::duration<double>(end - start_).count();
+        }
+    }
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    double* seconds_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+inline void track_bits(LLLStats& stats, const Rational& q) {
+    stats.max_num_bits = std::max(stats.max_num_bits, mpz_sizeinbase(q.get_num_mpz_t(), 2));
+    stats.max_den_bits = std::max(stats.max_den_bits, mpz_sizeinbase(q.get_den_mpz_t(), 2));
+}
+
+inline void track_bits(LLLStats& stats, ConstRow row) {
+    for (const auto& q : row) track_bits(stats, q);
+}
+
+// Integers only have a numerator
+inline void track_bits(LLLStats& stats, const mpz_class& z) {
+    stats.max_num_bits = std::max(stats.max_num_bits, mpz_sizeinbase(z.get_mpz_t(), 2));
+}
+
+inline void track_bits(LLLStats& stats, ConstIntRow row) {
+    for (const auto& z : row) track_bits(stats, z);
+}
+
+// One JSON trace line after a swap at index k
+inline void trace_swap(const LLLStats& stats, size_t k) {
+    if (!stats.trace) return;
+    *stats.trace << "{\"event\":\"swap\",\"k\":" << k
+                 << ",\"swaps\":" << stats.swaps
+                 << ",\"size_reductions\":" << stats.size_reductions
+                 << ",\"max_num_bits\":" << stats.max_num_bits
+                 << ",\"max_den_bits\":" << stats.max_den_bits << "}\n";
+}
+
+// Final JSON trace line with the complete counters
+inline void trace_done(const LLLStats& stats) {
+    if (!stats.trace) return;
+    *stats.trace << "{\"event\":\"done\",\"stats\":";
+    write_stats_json(*stats.trace, stats);
+    *stats.trace << "}\n";
+}
+
+// Run a statement only when stats were requested
+#define LLL_STAT(stats, ...) do { if (stats) { __VA_ARGS__; } } while (0)
+// Time the rest of the enclosing scope into stats->field
+#define LLL_PHASE(stats, field) PhaseTimer lll_phase_timer_((stats) ? &(stats)->field : nullptr)
+
+#else
+
+#define LLL_STAT(stats, ...) ((void)(stats))
+#define LLL_PHASE(stats, field) ((void)(stats))
+
+#endif // LLLLIB_STATS
+
+#endif // LLL_STATS_H
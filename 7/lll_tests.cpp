@@ -0,0 +1,602 @@
+#include <algorithm>
+#include <csignal>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <gmpxx.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "llllib.h"
+#include "lattice_io.h"
+#include "coppersmith.h"
+#include "codec.h"
+#include "rsa.h"
+
+// Regression checks for llllib, run by ctest. Each group is selected by
+// name on the command line; a failed check is reported on stderr and the
+// process exits with 1.
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+using SmallBasis = std::vector<std::vector<long>>;
+
+static Matrix to_matrix(const SmallBasis& M) {
+    Matrix B(M.size(), M[0].size());
+    for (size_t i = 0; i < M.size(); ++i) {
+        for (size_t j = 0; j < M[i].size(); ++j) B[i][j] = M[i][j];
+    }
+    return B;
+}
+
+static Matrix to_matrix(const IntMatrix& M) {
+    Matrix B(M.rows(), M.cols());
+    for (size_t i = 0; i < M.rows(); ++i) {
+        for (size_t j = 0; j < M.cols(); ++j) B[i][j] = M[i][j];
+    }
+    return B;
+}
+
+// Knapsack-style basis: row i is [a_i, e_i] with a random bits-bit a_i, so
+// the rows are always independent and LLL has plenty of swaps to do
+static IntMatrix random_knapsack(gmp_randclass& rng, size_t n, size_t bits) {
+    IntMatrix B(n, n + 1, mpz_class(0));
+    for (size_t i = 0; i < n; ++i) {
+        B[i][0] = rng.get_z_bits(bits);
+        B[i][i+1] = 1;
+    }
+    return B;
+}
+
+static bool same_basis(const Matrix& A, const Matrix& B) {
+    if (A.rows() != B.rows() || A.cols() != B.cols()) return false;
+    for (size_t i = 0; i < A.rows(); ++i) {
+        for (size_t j = 0; j < A.cols(); ++j) {
+            if (A[i][j] != B[i][j]) return false;
+        }
+    }
+    return true;
+}
+
+// |mu_ij| ≤ 1/2 and the Lovász condition for every k, checked on a fresh GSO
+static bool is_lll_reduced(const Matrix& B, const Rational& delta) {
+    GramSchmidtResult gs = gram_schmidt(B);
+    for (size_t k = 1; k < B.rows(); ++k) {
+        for (size_t j = 0; j < k; ++j) {
+            if (abs(gs.mu[k][j]) > Rational(1, 2)) return false;
+        }
+        Rational mu = gs.mu[k][k-1];
+        if (gs.normsq[k] < (delta - mu * mu) * gs.normsq[k-1]) return false;
+    }
+    return true;
+}
+
+// Both bases span a lattice of the same covolume
+static bool same_volume(const Matrix& A, const Matrix& B) {
+    GramSchmidtResult ga = gram_schmidt(A);
+    GramSchmidtResult gb = gram_schmidt(B);
+    Rational va = 1, vb = 1;
+    for (size_t i = 0; i < A.rows(); ++i) va *= ga.normsq[i];
+    for (size_t i = 0; i < B.rows(); ++i) vb *= gb.normsq[i];
+    return va == vb;
+}
+
+// ─── Integral LLL ────────────────────────────────────────────────────────
+
+static void testIntegral() {
+    gmp_randclass rng(gmp_randinit_default);
+    rng.seed(4);
+    for (size_t trial = 0; trial < 40; ++trial) {
+        size_t n = 2 + trial % 12;
+        size_t bits = 10 + 5 * (trial % 9);
+        IntMatrix B = random_knapsack(rng, n, bits);
+        Rational delta = trial % 2 ? Rational(3, 4) : Rational(9999, 10000);
+        check(same_basis(to_matrix(lll1_integral(B.clone(), delta)), lll1(to_matrix(B), delta)),
+              "lll1_integral == lll1, trial " + std::to_string(trial));
+    }
+}
+
+// ─── Scaled LLL ──────────────────────────────────────────────────────────
+
+static void testScaled() {
+    gmp_randclass rng(gmp_randinit_default);
+    rng.seed(23);
+    for (size_t trial = 0; trial < 30; ++trial) {
+        size_t n = 2 + trial % 8;
+        IntMatrix B = random_knapsack(rng, n, 20 + 10 * (trial % 4));
+        mpz_class X = 1 + mpz_class(rng.get_z_bits(1 + trial % 12));
+        std::vector<mpz_class> weights = coppersmith_weights(B.cols(), X);
+
+        // Reference: the rational X-scaled basis through lll1, first row unscaled
+        Matrix scaled = to_matrix(B);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < B.cols(); ++j) scaled[i][j] *= weights[j];
+        }
+        Matrix reduced = lll1(std::move(scaled));
+        std::vector<mpz_class> expected(B.cols());
+        for (size_t j = 0; j < B.cols(); ++j) {
+            Rational v = reduced[0][j] / weights[j];
+            expected[j] = v.get_num();
+            check(v.get_den() == 1, "rational reference unscales exactly");
+        }
+
+        std::string name = ", trial " + std::to_string(trial);
+        check(lll(B, X) == expected, "lll(B, X) matches the rational scaling" + name);
+        check(lll(B, weights) == expected, "lll(B, weights) matches the rational scaling" + name);
+    }
+}
+
+// ─── Parallel LLL ────────────────────────────────────────────────────────
+
+// Build with -DLLL_TSAN=ON to run this group under ThreadSanitizer
+static void testParallel() {
+    gmp_randclass rng(gmp_randinit_default);
+    rng.seed(12);
+    for (size_t trial = 0; trial < 8; ++trial) {
+        size_t n = 8 + 2 * trial;
+        IntMatrix B = random_knapsack(rng, n, 3 * n);
+        Matrix expected = lll1(to_matrix(B));
+        for (size_t threads : {2, 4}) {
+            check(same_basis(lll1_parallel(to_matrix(B), threads), expected),
+                  "lll1_parallel == lll1, n = " + std::to_string(n)
+                  + ", threads " + std::to_string(threads));
+        }
+    }
+}
+
+// ─── Segment LLL ─────────────────────────────────────────────────────────
+
+static void testSegment() {
+    Rational delta(9999, 10000);
+
+    // mu_10 = 1/2 exactly: rounding it would flip the sign on every phase
+    std::vector<SmallBasis> cases = {
+        {{2, 0, 0}, {1, 5, 0}, {0, 0, 7}},
+        {{2, 0, 0, 0}, {1, 5, 0, 0}, {0, 0, 2, 0}, {0, 0, 1, 7}},
+        {{2, 0, 0, 0, 0}, {-1, 5, 0, 0, 0}, {0, 1, 2, 0, 0}, {0, 0, 0, 6, 0}, {0, 0, 0, 3, 9}},
+    };
+    for (size_t c = 0; c < cases.size(); ++c) {
+        Matrix B = to_matrix(cases[c]);
+        for (size_t threads : {1, 2}) {
+            Matrix reduced = lll_segment(B.clone(), 2, threads, delta);
+            std::string name = "lll_segment case " + std::to_string(c) +
+                               ", threads " + std::to_string(threads);
+            check(is_lll_reduced(reduced, delta), name + " is LLL-reduced");
+            check(same_volume(B, reduced), name + " keeps the lattice volume");
+        }
+    }
+}
+
+// ─── Lattice Files ───────────────────────────────────────────────────────
+
+// Overwrite one uint64 field of a table header in place
+static void patch_header(const std::string& path, size_t offset, uint64_t value) {
+    std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(offset);
+    f.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static bool rejects_table(const std::string& path) {
+    try {
+        MappedTable table(path);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+static void testLatticeIO() {
+    std::string path = "lll_tests_table.bin";
+    IntMatrix B = {{mpz_class(3), mpz_class(-1)}, {mpz_class("123456789012345678901234567890"), mpz_class(0)}};
+
+    write_matrix_file(path, B);
+    IntMatrix C = read_matrix_file(path);
+    bool same = C.rows() == B.rows() && C.cols() == B.cols();
+    for (size_t i = 0; same && i < B.rows(); ++i) {
+        for (size_t j = 0; j < B.cols(); ++j) same = same && C[i][j] == B[i][j];
+    }
+    check(same, "matrix table round trip");
+
+    // An index offset near 2^64 must not wrap past the data offset check
+    patch_header(path, offsetof(TableHeader, rows), uint64_t(1) << 36);
+    patch_header(path, offsetof(TableHeader, cols), 1);
+    patch_header(path, offsetof(TableHeader, index_offset), -(uint64_t(1) << 40));
+    check(rejects_table(path), "wrapping index offset is rejected");
+
+    // Index inside the header, and index past the data
+    write_matrix_file(path, B);
+    patch_header(path, offsetof(TableHeader, index_offset), 0);
+    check(rejects_table(path), "index overlapping the header is rejected");
+    write_matrix_file(path, B);
+    patch_header(path, offsetof(TableHeader, rows), 3);
+    check(rejects_table(path), "index running into the data is rejected");
+
+    std::remove(path.c_str());
+}
+
+// ─── Checkpoints ─────────────────────────────────────────────────────────
+
+static bool rejects_checkpoint(const std::string& path) {
+    try {
+        read_checkpoint(path);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// Thrown by InterruptBuf to stop a run at a fixed point
+struct Interrupted {};
+
+// Stream buffer that throws Interrupted on the first write after `lines`
+// complete lines. A stream over it with exceptions(badbit) passes the
+// exception on, so a run reporting to it stops there and leaves its last
+// checkpoint behind.
+class InterruptBuf : public std::streambuf {
+public:
+    explicit InterruptBuf(size_t lines) : lines_(lines) {}
+
+protected:
+    int overflow(int c) override {
+        if (lines_ == 0) throw Interrupted();
+        if (c == '\n') lines_--;
+        return c;
+    }
+
+private:
+    size_t lines_;
+};
+
+static bool same_norms(const Vector& a, const Vector& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+static void testCheckpoint() {
+    std::string path = "lll_tests_checkpoint.txt";
+    std::string header = "llllib-checkpoint 2\nalgorithm lll1\nk 1\n";
+    std::string tail = "bkz 0 0 0 0\ntour_norms 0\nbasis 2 2\n";
+
+    // A zero denominator must be reported, not divided by
+    std::ofstream(path) << header << "delta 1/0\n" << tail << "1 0\n0 1\n";
+    check(rejects_checkpoint(path), "delta 1/0 is rejected");
+    std::ofstream(path) << header << "delta 3/4\n" << tail << "1 0\n0 3/0\n";
+    check(rejects_checkpoint(path), "basis entry 3/0 is rejected");
+    std::remove(path.c_str());
+
+    // A failed rename leaves no .tmp file behind
+    std::string dir = "lll_tests_checkpoint_dir";
+    mkdir(dir.c_str(), 0700);
+    CheckpointState state;
+    state.basis = to_matrix(SmallBasis{{1, 0}, {0, 1}});
+    bool threw = false;
+    try {
+        write_checkpoint(dir, state);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    check(threw, "write_checkpoint over a directory throws");
+    check(!std::ifstream(dir + ".tmp"), "failed write_checkpoint removes its .tmp file");
+    std::remove((dir + ".tmp").c_str());
+    rmdir(dir.c_str());
+}
+
+// ─── Codec ───────────────────────────────────────────────────────────────
+
+static void testCodec() {
+    std::vector<mpz_class> numbers = {5, 0, mpz_class("123456789012345678901234567890"), 0, 0, 255, 256};
+    // Text lines cannot hold newlines or surrounding spaces, so only words
+    std::vector<mpz_class> words = {from_text("plain"), 0, from_text("text"), 0};
+    for (Encoding encoding : {Encoding::Decimal, Encoding::Hex, Encoding::Base64, Encoding::Text}) {
+        const auto& values = encoding == Encoding::Text ? words : numbers;
+        std::stringstream stream;
+        for (const auto& x : values) {
+            write_integer(stream, x, encoding);
+            stream << '\n';
+        }
+        IntegerReader reader(stream, encoding);
+        std::vector<mpz_class> read;
+        mpz_class x;
+        while (reader.next(x)) read.push_back(x);
+        check(read == values, "write_integer / IntegerReader round trip with zeros, encoding "
+                              + std::to_string(static_cast<int>(encoding)));
+    }
+}
+
+// ─── RSA Decryption ──────────────────────────────────────────────────────
+
+static void testRSA() {
+    // e ≡ 0 mod (p − 1) or mod (q − 1) makes a CRT exponent 0, which must
+    // still give 0 for ciphertexts sharing a factor with n
+    mpz_class p = 11, q = 13, n = p * q;
+    for (long e : {1, 7, 10, 12, 60, 61, 120}) {
+        CRTKey key = make_crt_key(p, q, e);
+        bool ok = true;
+        for (mpz_class c = 0; c < n; ++c) {
+            mpz_class expected;
+            mpz_powm_ui(expected.get_mpz_t(), c.get_mpz_t(), e, n.get_mpz_t());
+            ok = ok && crt_decrypt(key, c) == expected;
+        }
+        check(ok, "crt_decrypt == c^e mod n for every c, e = " + std::to_string(e));
+    }
+
+    bool threw = false;
+    try {
+        make_crt_key(p, q, 0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check(threw, "make_crt_key rejects e = 0");
+}
+
+// ─── Polynomial GCD and Integer Roots ───────────────────────────────────
+
+// Roots of f in [−bound, bound] by evaluating at every point
+static std::vector<mpz_class> brute_force_roots(const Polynomial& f, long bound) {
+    std::vector<mpz_class> roots;
+    for (long x = -bound; x <= bound; ++x) {
+        if (poly_eval(f, mpz_class(x)) == 0) roots.push_back(x);
+    }
+    return roots;
+}
+
+static std::string to_string(const Polynomial& f) {
+    std::string s = "[";
+    for (size_t i = 0; i < f.size(); ++i) s += (i ? " " : "") + f[i].get_str();
+    return s + "]";
+}
+
+static void testRoots() {
+    gmp_randclass rng(gmp_randinit_default);
+    rng.seed(18);
+    auto random = [&](long lo, long hi) -> long {
+        return lo + mpz_class(rng.get_z_range(hi - lo + 1)).get_si();
+    };
+    const long bound = 60;
+
+    // f and g are products of primitive linear factors a·x − r with a > 0,
+    // drawn with repetition from a small pool so that roots repeat, times a
+    // random content. The gcd is then the product of the shared factors to
+    // their lower multiplicity, and the integer roots are the factors with a = 1.
+    for (int trial = 0; trial < 200; ++trial) {
+        std::vector<std::pair<long, long>> pool;
+        while (pool.size() < 6) {
+            long a = trial % 3 == 0 ? random(1, 3) : 1;
+            long r = random(-50, 50);
+            if (mpz_class(std::gcd(a, r)) != 1) continue;
+            if (std::find(pool.begin(), pool.end(), std::make_pair(a, r)) == pool.end()) {
+                pool.push_back({a, r});
+            }
+        }
+        std::vector<int> in_f(pool.size()), in_g(pool.size());
+        for (size_t i = 0; i < pool.size(); ++i) {
+            in_f[i] = random(0, 3);
+            in_g[i] = random(0, 2);
+        }
+
+        Polynomial f{random(1, 5)}, g{random(1, 5)}, common{1};
+        for (size_t i = 0; i < pool.size(); ++i) {
+            Polynomial factor{-pool[i].second, pool[i].first};
+            for (int e = 0; e < in_f[i]; ++e) f = poly_mul(f, factor);
+            for (int e = 0; e < in_g[i]; ++e) g = poly_mul(g, factor);
+            for (int e = 0; e < std::min(in_f[i], in_g[i]); ++e) common = poly_mul(common, factor);
+        }
+
+        Polynomial gcd = poly_gcd(f, g);
+        check(gcd == common, "poly_gcd(" + to_string(f) + ", " + to_string(g) + ") = "
+                             + to_string(gcd) + ", expected " + to_string(common));
+
+        if (degree(f) > 0) {
+            check(integer_roots(f, bound) == brute_force_roots(f, bound),
+                  "integer_roots(" + to_string(f) + ")");
+            check(integer_roots(f, 10) == brute_force_roots(f, 10),
+                  "integer_roots(" + to_string(f) + ") with bound 10");
+        } else {
+            check(integer_roots(f, bound).empty(), "integer_roots of constant " + to_string(f));
+        }
+    }
+
+    // A single root of multiplicity 40 keeps every prime from working and
+    // forces the squarefree fallback
+    Polynomial power{1};
+    for (int e = 0; e < 40; ++e) power = poly_mul(power, Polynomial{-7, 1});
+    check(integer_roots(power, bound) == std::vector<mpz_class>{7}, "integer_roots((x − 7)^40)");
+
+    check(integer_roots(Polynomial{5}, bound).empty(), "a non-zero constant has no roots");
+    check(integer_roots(Polynomial{0, 1}, 0) == std::vector<mpz_class>{0}, "root 0 with bound 0");
+    bool threw = false;
+    try {
+        integer_roots(Polynomial{0}, bound);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check(threw, "the zero polynomial is rejected");
+}
+
+// ─── Checkpoint Resume ───────────────────────────────────────────────────
+
+static void testResumeLLL() {
+    std::string path = "lll_tests_resume_lll1.txt";
+    CheckpointParams checkpoint{path, 0};   // interval 0: a checkpoint every step
+    CheckpointParams resume{path, 3600};    // resumed runs need not write again
+    Rational delta(9999, 10000);
+    gmp_randclass rng(gmp_randinit_default);
+    rng.seed(24);
+
+    for (size_t trial = 0; trial < 4; ++trial) {
+        Matrix B = to_matrix(random_knapsack(rng, 8 + 2 * trial, 60));
+        if (trial % 2) {
+            // Rational entries must survive the text format too
+            for (size_t i = 0; i < B.rows(); ++i) B[i][1] /= 3;
+        }
+        Matrix expected = lll1(B.clone(), delta);
+        std::string name = ", trial " + std::to_string(trial);
+
+        // A checkpoint at the very start is a plain write-then-resume
+        CheckpointState state;
+        state.basis = B.clone();
+        state.delta = delta;
+        write_checkpoint(path, state);
+        check(same_basis(lll1_resume(resume, delta), expected),
+              "lll1_resume from k = 1 == lll1" + name);
+        check(!std::ifstream(path), "lll1_resume removes the finished checkpoint" + name);
+
+#if LLLLIB_STATS
+        // Stop after a number of swaps through the trace stream
+        for (size_t swaps : {0, 3, 10, 40}) {
+            InterruptBuf buf(swaps);
+            std::ostream trace(&buf);
+            trace.exceptions(std::ios::badbit);
+            LLLStats stats;
+            stats.trace = &trace;
+            bool interrupted = false;
+            try {
+                lll1_checkpointed(B.clone(), checkpoint, delta, &stats);
+            } catch (const Interrupted&) {
+                interrupted = true;
+            }
+            std::string where = name + " after " + std::to_string(swaps) + " swaps";
+            check(interrupted, "lll1_checkpointed is interrupted" + where);
+            if (!interrupted) continue;
+            check(same_basis(lll1_resume(resume, delta), expected), "lll1_resume == lll1" + where);
+        }
+#endif
+    }
+    std::remove(path.c_str());
+}
+
+// Run bkz in a child process and kill it once its checkpoint is at block
+// j ≥ min_j of tour ≥ min_tour, so the file holds a position inside a tour.
+// Where exactly it stops depends on timing, but any checkpoint must resume
+// to the same result. False if the run finished first.
+static bool kill_bkz_mid_tour(const Matrix& B, const BKZParams& params,
+                              size_t min_tour, size_t min_j) {
+    const std::string& path = params.checkpoint.path;
+    std::remove(path.c_str());
+    pid_t pid = fork();
+    if (pid == 0) {
+        bkz(B.clone(), params);
+        _exit(0);
+    }
+    int status = 0;
+    for (;;) {
+        if (waitpid(pid, &status, WNOHANG) == pid) return false;
+        try {
+            CheckpointState state = read_checkpoint(path);
+            if (state.tour >= min_tour && state.j >= min_j) break;
+        } catch (const std::runtime_error&) {
+            // Not written yet
+        }
+        usleep(1000);
+    }
+    kill(pid, SIGKILL);
+    waitpid(pid, &status, 0);
+    return WIFSIGNALED(status) && std::ifstream(path);
+}
+
+static void testResumeBKZ() {
+    std::string path = "lll_tests_resume_bkz.txt";
+    gmp_randclass rng(gmp_randinit_default);
+    rng.seed(25);
+
+    for (size_t trial = 0; trial < 3; ++trial) {
+        Matrix B = to_matrix(random_knapsack(rng, 10 + 2 * trial, 60));
+        BKZParams params;
+        params.block_size = 4 + trial;
+        params.early_abort = false;
+        params.max_tours = 2;
+        BKZResult expected = bkz(B.clone(), params);
+        std::string name = ", trial " + std::to_string(trial);
+
+        params.checkpoint = CheckpointParams{path, 0};
+        BKZParams resume = params;
+        resume.checkpoint.interval_seconds = 3600;
+        CheckpointState state;
+        state.algorithm = "bkz";
+        state.basis = B.clone();
+        state.delta = params.delta;
+        state.block_size = params.block_size;
+        write_checkpoint(path, state);
+        BKZResult resumed = bkz_resume(resume);
+        check(same_basis(resumed.basis, expected.basis) && same_norms(resumed.tour_norms, expected.tour_norms),
+              "bkz_resume from the start == bkz" + name);
+
+        // Stop on the progress line after the LLL preprocessing (0) or after
+        // tour t: the checkpoint then holds the preprocessing loop index, or
+        // the last block of the tour still to do
+        for (size_t lines = 0; lines < expected.tour_norms.size(); ++lines) {
+            InterruptBuf buf(lines);
+            std::ostream progress(&buf);
+            progress.exceptions(std::ios::badbit);
+            params.progress = &progress;
+            bool interrupted = false;
+            try {
+                bkz(B.clone(), params);
+            } catch (const Interrupted&) {
+                interrupted = true;
+            }
+            params.progress = nullptr;
+            std::string where = name + " after " + std::to_string(lines) + " progress lines";
+            check(interrupted, "bkz is interrupted" + where);
+            if (!interrupted) continue;
+            resumed = bkz_resume(resume);
+            check(same_basis(resumed.basis, expected.basis), "bkz_resume basis == bkz" + where);
+            check(same_norms(resumed.tour_norms, expected.tour_norms), "bkz_resume tour norms == bkz" + where);
+        }
+
+        // Positions inside a tour, early and halfway through
+        for (size_t tour = 1; tour < expected.tour_norms.size(); ++tour) {
+            for (size_t j : {size_t(1), B.rows() / 2}) {
+                if (!kill_bkz_mid_tour(B, params, tour, j)) continue;
+                CheckpointState killed = read_checkpoint(path);
+                resumed = bkz_resume(resume);
+                std::string where = name + " killed at tour " + std::to_string(killed.tour)
+                                  + ", block " + std::to_string(killed.j);
+                check(same_basis(resumed.basis, expected.basis), "bkz_resume basis == bkz" + where);
+                check(same_norms(resumed.tour_norms, expected.tour_norms), "bkz_resume tour norms == bkz" + where);
+            }
+        }
+    }
+    std::remove(path.c_str());
+    std::remove((path + ".tmp").c_str());   // a killed run may leave one
+}
+
+int main(int argc, char* argv[]) {
+    const std::map<std::string, void (*)()> groups = {
+        {"segment", testSegment},
+        {"integral", testIntegral},
+        {"scaled", testScaled},
+        {"parallel", testParallel},
+        {"lattice_io", testLatticeIO},
+        {"checkpoint", testCheckpoint},
+        {"codec", testCodec},
+        {"rsa", testRSA},
+        {"resume_lll1", testResumeLLL},
+        {"resume_bkz", testResumeBKZ},
+        {"roots", testRoots},
+    };
+    if (argc != 2 || groups.count(argv[1]) == 0) {
+        std::cerr << "Usage: " << argv[0] << " <group>" << std::endl;
+        return 2;
+    }
+    groups.at(argv[1])();
+    return failures == 0 ? 0 : 1;
+}
@@ -1,10 +1,17 @@
 #include "llllib.h"
+#include "thread_pool.h"
+#include "lll_stats.h"
+#include "lll_checkpoint.h"
 #include <stdexcept>
 #include <algorithm>
+#include <ostream>
+#include <functional>
+#include <cstdint>
+#include <string>
 
 // ─── Basic Vector Helpers ────────────────────────────────────────────────
 
-Rational dot(const Vector& u, const Vector& v) {
+Rational dot(ConstRow u, ConstRow v) {
     if (u.size() != v.size()) {
         throw std::invalid_argument("Vectors must have same length");
     }
@@ -15,7 +22,18 @@ Rational dot(const Vector& u, const Vector& v) {
     return sum;
 }
 
-Vector scalar_mult(const Rational& c, const Vector& v) {
+mpz_class dot(ConstIntRow u, ConstIntRow v) {
+    if (u.size() != v.size()) {
+        throw std::invalid_argument("Vectors must have same length");
+    }
+    mpz_class sum = 0;
+    for (size_t i = 0; i < u.size(); ++i) {
+        mpz_addmul(sum.get_mpz_t(), u[i].get_mpz_t(), v[i].get_mpz_t());
+    }
+    return sum;
+}
+
+Vector scalar_mult(const Rational& c, ConstRow v) {
     Vector result(v.size());
     for (size_t i = 0; i < v.size(); ++i) {
         result[i] = c * v[i];
@@ -23,7 +41,7 @@ Vector scalar_mult(const Rational& c, const Vector& v) {
     return result;
 }
 
-Vector vector_sub(const Vector& u, const Vector& v) {
+Vector vector_sub(ConstRow u, ConstRow v) {
     if (u.size() != v.size()) {
         throw std::invalid_argument("Vectors must have same length");
     }
@@ -35,127 +53,811 @@ Vector vector_sub(const Vector& u, const Vector& v) {
 }
 
 mpz_class frac_round(const Rational& frac) {
-    // Python's Fraction rounding: round half away from zero
-    // For positive: (2*n + d) // (2*d)
-    // For negative: we need to handle it carefully
+    mpz_class q;
+    frac_round(q, frac);
+    return q;
+}
+
+void frac_round(mpz_class& q, const Rational& frac) {
+    // Python's Fraction rounding: round half away from zero, i.e.
+    // sign(n)·floor((|n| + d/2) / d). With |n| = q·d + r that is q + 1
+    // exactly when 2r ≥ d. The remainder is per-thread scratch, so this
+    // does not allocate once its limbs have grown to size.
+    static thread_local mpz_class r;
+    const mpz_class& n = frac.get_num();
+    const mpz_class& d = frac.get_den();
+
+    mpz_fdiv_qr(q.get_mpz_t(), r.get_mpz_t(), n.get_mpz_t(), d.get_mpz_t());
+    // Now n = q·d + r with 0 ≤ r < d; round up when r ≥ d − r, and for
+    // n < 0 an exact half (2r = d) rounds down instead, away from zero
+    mpz_mul_2exp(r.get_mpz_t(), r.get_mpz_t(), 1);
+    int c = mpz_cmp(r.get_mpz_t(), d.get_mpz_t());
+    if (c > 0 || (c == 0 && mpz_sgn(n.get_mpz_t()) >= 0)) {
+        mpz_add_ui(q.get_mpz_t(), q.get_mpz_t(), 1);
+    }
+}
+
+// ─── In-Place Row Kernels ────────────────────────────────────────────────
 
-    mpz_class n = frac.get_num();
-    mpz_class d = frac.get_den();
+// Scratch values are per thread and keep their limbs between calls, so in
+// steady state the kernels below do not touch the allocator at all.
 
-    // Check the sign
-    if (n >= 0) {
-        // Positive: round half up
-        return (2 * n + d) / (2 * d);
-    } else {
-        // Negative: round half down (away from zero)
-        // This is equivalent to: -round(abs(frac))
-        return (2 * n - d) / (2 * d);
+// x -= q·y with an integer q
+static void submul(Rational& x, const mpz_class& q, const Rational& y) {
+    if (mpz_cmp_ui(x.get_den_mpz_t(), 1) == 0 && mpz_cmp_ui(y.get_den_mpz_t(), 1) == 0) {
+        mpz_submul(x.get_num_mpz_t(), q.get_mpz_t(), y.get_num_mpz_t());
+        return;
     }
+    static thread_local Rational scratch;
+    mpq_set_z(scratch.get_mpq_t(), q.get_mpz_t());
+    mpq_mul(scratch.get_mpq_t(), scratch.get_mpq_t(), y.get_mpq_t());
+    mpq_sub(x.get_mpq_t(), x.get_mpq_t(), scratch.get_mpq_t());
+}
+
+// x -= c·y
+static void submul(Rational& x, const Rational& c, const Rational& y) {
+    static thread_local Rational scratch;
+    mpq_mul(scratch.get_mpq_t(), c.get_mpq_t(), y.get_mpq_t());
+    mpq_sub(x.get_mpq_t(), x.get_mpq_t(), scratch.get_mpq_t());
+}
+
+// x += c·y
+static void addmul(Rational& x, const Rational& c, const Rational& y) {
+    static thread_local Rational scratch;
+    mpq_mul(scratch.get_mpq_t(), c.get_mpq_t(), y.get_mpq_t());
+    mpq_add(x.get_mpq_t(), x.get_mpq_t(), scratch.get_mpq_t());
+}
+
+void row_submul(Row row, ConstRow src, const mpz_class& q) {
+    for (size_t i = 0; i < row.size(); ++i) {
+        submul(row[i], q, src[i]);
+    }
+}
+
+void row_submul(Row row, ConstRow src, const Rational& c) {
+    for (size_t i = 0; i < row.size(); ++i) {
+        submul(row[i], c, src[i]);
+    }
+}
+
+void row_addmul(Row row, ConstRow src, const Rational& c) {
+    for (size_t i = 0; i < row.size(); ++i) {
+        addmul(row[i], c, src[i]);
+    }
+}
+
+void row_submul(IntRow row, ConstIntRow src, const mpz_class& q) {
+    for (size_t i = 0; i < row.size(); ++i) {
+        mpz_submul(row[i].get_mpz_t(), q.get_mpz_t(), src[i].get_mpz_t());
+    }
+}
+
+// ─── Common-Denominator Vectors ──────────────────────────────────────────
+
+CommonDenVector to_common_den(ConstRow v) {
+    CommonDenVector r;
+    for (const auto& x : v) {
+        mpz_lcm(r.den.get_mpz_t(), r.den.get_mpz_t(), x.get_den_mpz_t());
+    }
+    r.num.resize(v.size());
+    mpz_class scale;
+    for (size_t i = 0; i < v.size(); ++i) {
+        mpz_divexact(scale.get_mpz_t(), r.den.get_mpz_t(), v[i].get_den_mpz_t());
+        r.num[i] = v[i].get_num() * scale;
+    }
+    return r;
+}
+
+void to_rational(const CommonDenVector& v, Row out, size_t first) {
+    if (first > v.num.size() || out.size() > v.num.size() - first) {
+        throw std::invalid_argument("Vectors must have same length");
+    }
+    for (size_t i = 0; i < out.size(); ++i) {
+        mpz_set(out[i].get_num_mpz_t(), v.num[first + i].get_mpz_t());
+        mpz_set(out[i].get_den_mpz_t(), v.den.get_mpz_t());
+        out[i].canonicalize();
+    }
+}
+
+void normalize(CommonDenVector& v) {
+    mpz_class g = v.den;
+    for (const auto& x : v.num) {
+        if (g == 1) return;
+        mpz_gcd(g.get_mpz_t(), g.get_mpz_t(), x.get_mpz_t());
+    }
+    if (g == 1) return;
+    for (auto& x : v.num) {
+        mpz_divexact(x.get_mpz_t(), x.get_mpz_t(), g.get_mpz_t());
+    }
+    mpz_divexact(v.den.get_mpz_t(), v.den.get_mpz_t(), g.get_mpz_t());
+}
+
+Rational dot(const CommonDenVector& u, const CommonDenVector& v) {
+    if (u.num.size() != v.num.size()) {
+        throw std::invalid_argument("Vectors must have same length");
+    }
+    Rational sum;
+    mpz_class& acc = sum.get_num();
+    for (size_t i = 0; i < u.num.size(); ++i) {
+        mpz_addmul(acc.get_mpz_t(), u.num[i].get_mpz_t(), v.num[i].get_mpz_t());
+    }
+    mpz_mul(sum.get_den_mpz_t(), u.den.get_mpz_t(), v.den.get_mpz_t());
+    sum.canonicalize();
+    return sum;
 }
 
 // ─── Gram–Schmidt + LLL ──────────────────────────────────────────────────
 
-GramSchmidtResult gram_schmidt(const std::vector<Vector>& B) {
-    size_t n = B.size();
+// ─── Parallel Row Splitting ──────────────────────────────────────────────
+
+// Rows shorter than this many GMP elements per thread stay on the caller
+static const size_t parallel_min_chunk = 4;
 
-    Matrix mu(n, Vector(n, Rational(0)));
-    std::vector<Vector> Bstar(n);
-    Vector normsq(n);
+// Run fn(begin, end) over [0, count) split into one contiguous chunk per
+// pool thread. Without a pool, or when the range is too short to pay for
+// the hand-off, the whole range runs on the calling thread. All arithmetic
+// is exact and every element is written by exactly one chunk, so the
+// result never depends on the split.
+static void for_chunks(ThreadPool* pool, size_t count,
+                       const std::function<void(size_t, size_t)>& fn) {
+    size_t chunks = pool ? std::min(pool->size(), count / parallel_min_chunk) : 1;
+    if (chunks <= 1) {
+        fn(0, count);
+        return;
+    }
+    pool->parallel_for(chunks, [&](size_t c) {
+        fn(count * c / chunks, count * (c + 1) / chunks);
+    });
+}
+
+// Elements [lo, hi) of a row
+template <typename T>
+static RowView<T> slice(RowView<T> row, size_t lo, size_t hi) {
+    return {row.data() + lo, hi - lo};
+}
+
+static GramSchmidtResult gram_schmidt(const Matrix& B, ThreadPool* pool) {
+    size_t n = B.rows();
+    size_t m = B.cols();
+
+    GramSchmidtResult gs{Matrix(n, n, Rational(0)), Matrix(n, m), Vector(n)};
+    Matrix& mu = gs.mu;
+    Matrix& Bstar = gs.Bstar;
+    Vector& normsq = gs.normsq;
+
+    // b*_j as integer rows over a shared denominator
+    std::vector<CommonDenVector> bstar(n);
+    Vector scale(n);
+    std::vector<mpz_class> coeff(n);
 
     for (size_t i = 0; i < n; ++i) {
-        Vector v = B[i];
+        CommonDenVector bi = to_common_den(B[i]);
 
+        // mu_ij only needs b_i and the finished b*_j, so all j are independent
+        for_chunks(pool, i, [&](size_t lo, size_t hi) {
+            for (size_t j = lo; j < hi; ++j) {
+                mu[i][j] = dot(bi, bstar[j]) / normsq[j];
+            }
+        });
+
+        // b*_i = b_i − Σ c_j·num(b*_j) with c_j = mu_ij / den(b*_j), over
+        // the common denominator D = lcm(den(b_i), den(c_j)). Every term
+        // then has an integer coefficient and each column is a plain
+        // multiply-accumulate.
+        CommonDenVector& v = bstar[i];
+        v.den = bi.den;
+        for (size_t j = 0; j < i; ++j) {
+            scale[j] = mu[i][j] / Rational(bstar[j].den);
+            mpz_lcm(v.den.get_mpz_t(), v.den.get_mpz_t(), scale[j].get_den_mpz_t());
+        }
+        mpz_class base;
+        mpz_divexact(base.get_mpz_t(), v.den.get_mpz_t(), bi.den.get_mpz_t());
         for (size_t j = 0; j < i; ++j) {
-            mu[i][j] = dot(B[i], Bstar[j]) / normsq[j];
-            v = vector_sub(v, scalar_mult(mu[i][j], Bstar[j]));
+            mpz_divexact(coeff[j].get_mpz_t(), v.den.get_mpz_t(), scale[j].get_den_mpz_t());
+            coeff[j] *= scale[j].get_num();
         }
 
-        Bstar[i] = v;
-        normsq[i] = dot(v, v);
+        v.num.resize(m);
+        for_chunks(pool, m, [&](size_t lo, size_t hi) {
+            for (size_t c = lo; c < hi; ++c) {
+                mpz_mul(v.num[c].get_mpz_t(), bi.num[c].get_mpz_t(), base.get_mpz_t());
+                for (size_t j = 0; j < i; ++j) {
+                    mpz_submul(v.num[c].get_mpz_t(), coeff[j].get_mpz_t(),
+                               bstar[j].num[c].get_mpz_t());
+                }
+            }
+        });
+        normalize(v);
 
+        normsq[i] = dot(v, v);
         if (normsq[i] == 0) {
             throw std::runtime_error("Input basis is linearly dependent.");
         }
+
+        for_chunks(pool, m, [&](size_t lo, size_t hi) {
+            to_rational(v, slice(Bstar[i], lo, hi), lo);
+        });
+    }
+
+    return gs;
+}
+
+GramSchmidtResult gram_schmidt(const Matrix& B) {
+    return gram_schmidt(B, nullptr);
+}
+
+void write_stats_json(std::ostream& os, const LLLStats& stats) {
+    // Timers are printed with full precision whatever the stream was set to
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision(9);
+    os.unsetf(std::ios_base::floatfield);
+    os << "{\"size_reductions\":" << stats.size_reductions
+       << ",\"swaps\":" << stats.swaps
+       << ",\"lovasz_tests\":" << stats.lovasz_tests
+       << ",\"gso_recomputations\":" << stats.gso_recomputations
+       << ",\"mpq_ops\":" << stats.mpq_ops
+       << ",\"gso_seconds\":" << stats.gso_seconds
+       << ",\"size_reduction_seconds\":" << stats.size_reduction_seconds
+       << ",\"lovasz_seconds\":" << stats.lovasz_seconds
+       << ",\"swap_seconds\":" << stats.swap_seconds
+       << ",\"max_num_bits\":" << stats.max_num_bits
+       << ",\"max_den_bits\":" << stats.max_den_bits << "}";
+    os.flags(flags);
+    os.precision(precision);
+}
+
+// Size-reduce b_k by q·b_j and update row k of mu in place.
+// B* and the norms are unchanged by this operation. Only mu entries
+// mu_kt with first ≤ t < j are updated (see reduce_segment).
+static void size_reduce_step(Matrix& B, GramSchmidtResult& gs,
+                             size_t k, size_t j, const mpz_class& q,
+                             ThreadPool* pool = nullptr, size_t first = 0) {
+    // Indices [0, m) are row k of B, [m, m + j − first) entries of mu_k
+    size_t m = B.cols();
+    for_chunks(pool, m + (j - first), [&](size_t lo, size_t hi) {
+        if (lo < m) {
+            size_t end = std::min(hi, m);
+            row_submul(slice(B[k], lo, end), slice(ConstRow(B[j]), lo, end), q);
+        }
+        if (hi > m) {
+            size_t start = first + (std::max(lo, m) - m);
+            size_t end = first + (hi - m);
+            row_submul(slice(gs.mu[k], start, end),
+                       slice(ConstRow(gs.mu[j]), start, end), q);
+        }
+    });
+    // mu_kj − q keeps the same (coprime) denominator
+    Rational& mu_kj = gs.mu[k][j];
+    mpz_submul(mu_kj.get_num_mpz_t(), q.get_mpz_t(), mu_kj.get_den_mpz_t());
+}
+
+// Swap b_{k-1} and b_k and update mu, B* and the norms with the
+// standard adjacent-swap formulas instead of recomputing the GSO.
+// Only mu entries with both indices in [first, last) are updated
+// (see reduce_segment).
+static void swap_step(Matrix& B, GramSchmidtResult& gs, size_t k,
+                      ThreadPool* pool = nullptr,
+                      size_t first = 0, size_t last = SIZE_MAX) {
+    size_t n = std::min(last, B.rows());
+    Matrix& mu = gs.mu;
+    Matrix& Bstar = gs.Bstar;
+    Vector& normsq = gs.normsq;
+
+    B.swap_rows(k, k-1);
+    for (size_t j = first; j + 1 < k; ++j) {
+        mu[k][j].swap(mu[k-1][j]);
+    }
+
+    // Per-thread scratch, bound to references so the workers below see
+    // the caller's values rather than their own thread_local copies
+    static thread_local Rational m_scratch, new_norm_scratch, new_mu_scratch;
+    Rational& m = m_scratch;
+    Rational& new_norm = new_norm_scratch;
+    Rational& new_mu = new_mu_scratch;
+
+    // new_norm = ||b*_k||² + m²·||b*_{k-1}||², new_mu = m·||b*_{k-1}||² / new_norm
+    mpq_set(m.get_mpq_t(), mu[k][k-1].get_mpq_t());
+    mpq_mul(new_mu.get_mpq_t(), m.get_mpq_t(), normsq[k-1].get_mpq_t());
+    mpq_mul(new_norm.get_mpq_t(), new_mu.get_mpq_t(), m.get_mpq_t());
+    mpq_add(new_norm.get_mpq_t(), new_norm.get_mpq_t(), normsq[k].get_mpq_t());
+    mpq_div(new_mu.get_mpq_t(), new_mu.get_mpq_t(), new_norm.get_mpq_t());
+
+    // ||b*_k||² becomes ||b*_{k-1}||²·||b*_k||² / new_norm
+    mpq_mul(normsq[k].get_mpq_t(), normsq[k].get_mpq_t(), normsq[k-1].get_mpq_t());
+    mpq_div(normsq[k].get_mpq_t(), normsq[k].get_mpq_t(), new_norm.get_mpq_t());
+    mpq_set(normsq[k-1].get_mpq_t(), new_norm.get_mpq_t());
+    mpq_set(mu[k][k-1].get_mpq_t(), new_mu.get_mpq_t());
+
+    // Indices [0, m) are the columns of B*, [m, m + n − k − 1) the rows
+    // i > k whose mu_{i,k-1} and mu_ik change.
+    //
+    // New b*_{k-1} is the old b*_k plus its projection onto old b*_{k-1},
+    // and the new b*_k is what remains of the old b*_{k-1}. Both are
+    // built in the opposite rows and then swapped into place.
+    size_t cols = B.cols();
+    for_chunks(pool, cols + (n - k - 1), [&](size_t lo, size_t hi) {
+        if (lo < cols) {
+            size_t end = std::min(hi, cols);
+            Row lower = slice(Bstar[k], lo, end);
+            Row upper = slice(Bstar[k-1], lo, end);
+            row_addmul(lower, upper, m);
+            row_submul(upper, lower, new_mu);
+            std::swap_ranges(lower.begin(), lower.end(), upper.begin());
+        }
+        if (hi > cols) {
+            size_t first = k + 1 + (std::max(lo, cols) - cols);
+            size_t last = k + 1 + (hi - cols);
+            for (size_t i = first; i < last; ++i) {
+                Rational& a = mu[i][k-1];
+                Rational& b = mu[i][k];
+                submul(a, m, b);        // a = mu_{i,k-1} − m·mu_{ik}  (new mu_ik)
+                addmul(b, new_mu, a);   // b = mu_ik + new_mu·a        (new mu_{i,k-1})
+                a.swap(b);
+            }
+        }
+    });
+}
+
+// Lovász condition ||b*_k||² ≥ (delta − mu_{k,k-1}²)·||b*_{k-1}||², on scratch
+static bool lovasz_holds(const GramSchmidtResult& gs, size_t k, const Rational& delta) {
+    static thread_local Rational t;
+    const Rational& mu = gs.mu[k][k-1];
+    mpq_mul(t.get_mpq_t(), mu.get_mpq_t(), mu.get_mpq_t());
+    mpq_sub(t.get_mpq_t(), delta.get_mpq_t(), t.get_mpq_t());
+    mpq_mul(t.get_mpq_t(), t.get_mpq_t(), gs.normsq[k-1].get_mpq_t());
+    return mpq_cmp(gs.normsq[k].get_mpq_t(), t.get_mpq_t()) >= 0;
+}
+
+// The lll1 loop from index k; pool (if any) splits the row updates of
+// each step. A checkpoint writer gets (B, k) whenever it is due.
+static void reduce(Matrix& B, GramSchmidtResult& gs, const Rational& delta,
+                   LLLStats* stats, ThreadPool* pool,
+                   CheckpointWriter* checkpoint = nullptr, size_t k = 1) {
+    Matrix& mu = gs.mu;
+
+    size_t n = B.rows();
+    mpz_class q;
+
+    while (k < n) {
+        if (checkpoint && checkpoint->due()) {
+            checkpoint->write(B, k);
+        }
+
+        // Size reduction
+        {
+            LLL_PHASE(stats, size_reduction_seconds);
+            for (int j = k - 1; j >= 0; --j) {
+                frac_round(q, mu[k][j]);
+                if (q != 0) {
+                    size_reduce_step(B, gs, k, j, q, pool);
+                    LLL_STAT(stats, stats->size_reductions++;
+                                    stats->mpq_ops += 2 * (B.cols() + j) + 1);
+                }
+            }
+            LLL_STAT(stats, track_bits(*stats, B[k]);
+                            track_bits(*stats, ConstRow(mu[k].data(), k)));
+        }
+
+        // Lovász condition
+        bool lovasz;
+        {
+            LLL_PHASE(stats, lovasz_seconds);
+            lovasz = lovasz_holds(gs, k, delta);
+            LLL_STAT(stats, stats->lovasz_tests++; stats->mpq_ops += 4);
+        }
+
+        if (lovasz) {
+            k++;
+        } else {
+            {
+                LLL_PHASE(stats, swap_seconds);
+                swap_step(B, gs, k, pool);
+                LLL_STAT(stats, stats->swaps++;
+                                stats->mpq_ops += 4 * B.cols() + 4 * (n - k - 1) + 7;
+                                track_bits(*stats, gs.normsq[k-1]);
+                                track_bits(*stats, gs.normsq[k]);
+                                track_bits(*stats, mu[k][k-1]));
+            }
+            LLL_STAT(stats, trace_swap(*stats, k));
+            k = std::max((int)k - 1, 1);
+        }
     }
 
-    return {mu, Bstar, normsq};
+    LLL_STAT(stats, trace_done(*stats));
 }
 
-std::vector<Vector> lll1(std::vector<Vector> B, const Rational& delta) {
-    // Convert all elements to Rational
-    for (auto& row : B) {
-        for (auto& elem : row) {
+void lll1_in_place(Matrix& B, GramSchmidtResult& gs, const Rational& delta, LLLStats* stats) {
+    reduce(B, gs, delta, stats, nullptr);
+}
+
+void lll1_in_place(Matrix& B, GramSchmidtResult& gs, const Rational& delta,
+                   LLLStats* stats, CheckpointWriter& checkpoint, size_t k) {
+    reduce(B, gs, delta, stats, nullptr, &checkpoint, k);
+}
+
+// Initial GSO for the lll1 loop, with its cost recorded in stats
+static GramSchmidtResult initial_gso(const Matrix& B, LLLStats* stats, ThreadPool* pool) {
+    GramSchmidtResult gs;
+    {
+        LLL_PHASE(stats, gso_seconds);
+        gs = gram_schmidt(B, pool);
+    }
+    LLL_STAT(stats, {
+        // Per row i: i dot products, divisions and row updates, plus ||b*_i||²
+        size_t n = B.rows(), m = B.cols();
+        stats->gso_recomputations++;
+        stats->mpq_ops += n * (n - 1) / 2 * (4 * m + 1) + 2 * m * n;
+        for (size_t i = 0; i < n; ++i) {
+            track_bits(*stats, ConstRow(gs.mu[i].data(), i));
+            track_bits(*stats, gs.normsq[i]);
+        }
+    });
+    return gs;
+}
+
+static Matrix lll1(Matrix B, const Rational& delta, LLLStats* stats, ThreadPool* pool) {
+    // Canonicalize all Rationals
+    for (size_t i = 0; i < B.rows(); ++i) {
+        for (auto& elem : B[i]) {
+            elem.canonicalize();
+        }
+    }
+
+    // The GSO is computed once and then kept up to date incrementally
+    GramSchmidtResult gs = initial_gso(B, stats, pool);
+    reduce(B, gs, delta, stats, pool);
+
+    return B;
+}
+
+Matrix lll1(Matrix B, const Rational& delta, LLLStats* stats) {
+    return lll1(std::move(B), delta, stats, nullptr);
+}
+
+Matrix lll1_parallel(Matrix B, size_t threads, const Rational& delta, LLLStats* stats) {
+    ThreadPool pool(threads);
+    return lll1(std::move(B), delta, stats, pool.size() > 1 ? &pool : nullptr);
+}
+
+// ─── Checkpointed LLL ────────────────────────────────────────────────────
+
+static Matrix lll1_from(Matrix B, size_t k, const CheckpointParams& checkpoint,
+                        const Rational& delta, LLLStats* stats) {
+    for (size_t i = 0; i < B.rows(); ++i) {
+        for (auto& elem : B[i]) {
+            elem.canonicalize();
+        }
+    }
+
+    CheckpointWriter writer(checkpoint, "lll1", delta);
+    GramSchmidtResult gs = initial_gso(B, stats, nullptr);
+    reduce(B, gs, delta, stats, nullptr, &writer, k);
+    writer.finish();
+    return B;
+}
+
+Matrix lll1_checkpointed(Matrix B, const CheckpointParams& checkpoint,
+                         const Rational& delta, LLLStats* stats) {
+    return lll1_from(std::move(B), 1, checkpoint, delta, stats);
+}
+
+Matrix lll1_resume(const CheckpointParams& checkpoint, const Rational& delta, LLLStats* stats) {
+    CheckpointState state = read_checkpoint(checkpoint.path);
+    if (state.algorithm != "lll1") {
+        throw std::invalid_argument("Not an lll1 checkpoint: " + checkpoint.path);
+    }
+    if (state.delta != delta) {
+        throw std::invalid_argument("Checkpoint was written with a different delta");
+    }
+    return lll1_from(std::move(state.basis), state.k, checkpoint, delta, stats);
+}
+
+Matrix lll_deep(Matrix B, size_t depth, const Rational& delta) {
+    for (size_t i = 0; i < B.rows(); ++i) {
+        for (auto& elem : B[i]) {
             elem.canonicalize();
         }
     }
 
-    GramSchmidtResult gs_result = gram_schmidt(B);
-    Matrix mu = gs_result.mu;
-    std::vector<Vector> Bstar = gs_result.Bstar;
-    Vector normsq = gs_result.normsq;
+    GramSchmidtResult gs = gram_schmidt(B);
+    Matrix& mu = gs.mu;
+    Vector& normsq = gs.normsq;
 
+    size_t n = B.rows();
     size_t k = 1;
+    mpz_class q;
 
-    while (k < 3) {
+    while (k < n) {
         // Size reduction
         for (int j = k - 1; j >= 0; --j) {
-            mpz_class q = frac_round(mu[k][j]);
+            frac_round(q, mu[k][j]);
             if (q != 0) {
-                Vector Bj_scaled = scalar_mult(Rational(q), B[j]);
-                B[k] = vector_sub(B[k], Bj_scaled);
+                size_reduce_step(B, gs, k, j, q);
             }
         }
 
-        gs_result = gram_schmidt(B);
-        mu = gs_result.mu;
-        Bstar = gs_result.Bstar;
-        normsq = gs_result.normsq;
+        // C is ||π_i(b_k)||², starting from ||b_k||² at i = 0
+        Rational C = normsq[k];
+        for (size_t j = 0; j < k; ++j) {
+            C += mu[k][j] * mu[k][j] * normsq[j];
+        }
+
+        size_t i = 0;
+        for (; i < k; ++i) {
+            bool allowed = depth == 0 || k - i <= depth;
+            if (allowed && C < delta * normsq[i]) break;
+            C -= mu[k][i] * mu[k][i] * normsq[i];
+        }
 
-        // Lovász condition
-        if (normsq[k] >= (delta - mu[k][k-1] * mu[k][k-1]) * normsq[k-1]) {
+        if (i == k) {
             k++;
         } else {
-            std::swap(B[k], B[k-1]);
-            gs_result = gram_schmidt(B);
-            mu = gs_result.mu;
-            Bstar = gs_result.Bstar;
-            normsq = gs_result.normsq;
-            k = std::max((int)k - 1, 1);
+            // Move b_k down to position i through adjacent swaps, each of
+            // which updates the existing GSO instead of recomputing it
+            for (size_t t = k; t > i; --t) {
+                swap_step(B, gs, t);
+            }
+            k = std::max<size_t>(i, 1);
+        }
+    }
+
+    return B;
+}
+
+// ─── Segment LLL ─────────────────────────────────────────────────────────
+
+/*
+ * |mu| > 1/2. frac_round sends an exact ±1/2 to ∓1/2, so reducing those
+ * would flip the entry on every phase and the phase loop would never go
+ * quiet; ±1/2 already meets the size condition and is left alone.
+ */
+static bool exceeds_half(const Rational& mu) {
+    return mpq_cmp_ui(mu.get_mpq_t(), 1, 2) > 0 || mpq_cmp_si(mu.get_mpq_t(), -1, 2) < 0;
+}
+
+/*
+ * lll1 restricted to the segment of rows [a, b). Size reduction is only
+ * against rows of the segment, and only B, B*, the norms and the mu
+ * entries with both indices in [a, b) are kept up to date, so segments
+ * that do not overlap touch disjoint data and can run concurrently. Mu
+ * entries linking the segment to other rows go stale and are refreshed
+ * by refresh_cross_mu. Returns true if the segment changed at all.
+ */
+static bool reduce_segment(Matrix& B, GramSchmidtResult& gs, size_t a, size_t b,
+                           const Rational& delta) {
+    Matrix& mu = gs.mu;
+    bool changed = false;
+    mpz_class q;
+
+    size_t k = a + 1;
+    while (k < b) {
+        for (size_t j = k; j-- > a;) {
+            if (!exceeds_half(mu[k][j])) continue;
+            frac_round(q, mu[k][j]);
+            size_reduce_step(B, gs, k, j, q, nullptr, a);
+            changed = true;
+        }
+
+        if (lovasz_holds(gs, k, delta)) {
+            k++;
+        } else {
+            swap_step(B, gs, k, nullptr, a, b);
+            changed = true;
+            k = std::max(k - 1, a + 1);
+        }
+    }
+    return changed;
+}
+
+/*
+ * After a phase the basis, B* and the norms are exact, and so is mu inside
+ * every segment. Recompute mu_ic = <b_i, b*_c> / ||b*_c||² for the entries
+ * that cross from a row into an earlier segment, where either segment
+ * changed, then size-reduce the changed rows against everything above.
+ */
+static void refresh_cross_mu(Matrix& B, GramSchmidtResult& gs,
+                             const std::vector<size_t>& bounds,
+                             const std::vector<char>& changed, ThreadPool* pool) {
+    size_t n = B.rows();
+    std::vector<size_t> segment(n);
+    for (size_t s = 0; s + 1 < bounds.size(); ++s) {
+        for (size_t i = bounds[s]; i < bounds[s+1]; ++i) segment[i] = s;
+    }
+
+    for_chunks(pool, n, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            size_t si = segment[i];
+            for (size_t c = 0; c < bounds[si]; ++c) {
+                if (changed[si] || changed[segment[c]]) {
+                    gs.mu[i][c] = dot(B[i], gs.Bstar[c]) / gs.normsq[c];
+                }
+            }
+        }
+    });
+
+    mpz_class q;
+    for (size_t k = 0; k < n; ++k) {
+        if (!changed[segment[k]]) continue;
+        for (size_t j = bounds[segment[k]]; j-- > 0;) {
+            if (!exceeds_half(gs.mu[k][j])) continue;
+            frac_round(q, gs.mu[k][j]);
+            size_reduce_step(B, gs, k, j, q, pool);
         }
     }
+}
 
+Matrix lll_segment(Matrix B, size_t segment_size, size_t threads, const Rational& delta) {
+    for (size_t i = 0; i < B.rows(); ++i) {
+        for (auto& elem : B[i]) {
+            elem.canonicalize();
+        }
+    }
+
+    size_t n = B.rows();
+    if (segment_size == 0) {
+        segment_size = std::max<size_t>(4, std::min<size_t>(16, n / 4));
+    }
+    if (segment_size < 2) {
+        throw std::invalid_argument("Segment size must be at least 2");
+    }
+
+    ThreadPool pool(threads);
+    ThreadPool* parallel = pool.size() > 1 ? &pool : nullptr;
+    GramSchmidtResult gs = gram_schmidt(B, parallel);
+
+    // Alternate between segments [tL, (t+1)L) and the same grid shifted by
+    // L/2, so every adjacent pair lies inside a segment in one of the two
+    // phases. Once two phases in a row change nothing, every pair satisfies
+    // the Lovász condition.
+    if (n > segment_size) {
+        size_t quiet = 0;
+        for (size_t phase = 0; quiet < 2; ++phase) {
+            std::vector<size_t> bounds{0};
+            size_t start = (phase % 2 == 0) ? segment_size : segment_size / 2;
+            for (size_t b = start; b < n; b += segment_size) bounds.push_back(b);
+            bounds.push_back(n);
+
+            size_t segments = bounds.size() - 1;
+            std::vector<char> changed(segments, 0);
+            pool.parallel_for(segments, [&](size_t s) {
+                Rational local_delta = delta;
+                changed[s] = reduce_segment(B, gs, bounds[s], bounds[s+1], local_delta);
+            });
+
+            if (std::find(changed.begin(), changed.end(), 1) == changed.end()) {
+                quiet++;
+            } else {
+                quiet = 0;
+                refresh_cross_mu(B, gs, bounds, changed, parallel);
+            }
+        }
+    }
+
+    // The global pass size-reduces across segments and picks up anything
+    // the local phases left, so the result meets the lll1 conditions
+    reduce(B, gs, delta, nullptr, parallel);
     return B;
 }
 
 // ─── Scaled LLL (Coppersmith Lattice) ───────────────────────────────────
 
-std::vector<mpz_class> lll(const std::vector<std::vector<mpz_class>>& B,
+IntMatrix scale_columns(const IntMatrix& B, const std::vector<mpz_class>& weights) {
+    if (B.empty()) {
+        throw std::invalid_argument("Basis must contain at least one vector");
+    }
+    size_t m = weights.size();
+    if (B.cols() != m) {
+        throw std::invalid_argument("Basis rows must match the number of weights");
+    }
+    for (const auto& w : weights) {
+        if (w == 0) {
+            throw std::invalid_argument("Column weights must be non-zero");
+        }
+    }
+
+    IntMatrix scaled(B.rows(), m);
+    for (size_t i = 0; i < B.rows(); ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            mpz_mul(scaled[i][j].get_mpz_t(), weights[j].get_mpz_t(), B[i][j].get_mpz_t());
+        }
+    }
+    return scaled;
+}
+
+std::vector<mpz_class> unscale(ConstIntRow v, const std::vector<mpz_class>& weights) {
+    if (v.size() != weights.size()) {
+        throw std::invalid_argument("Vector length must match the number of weights");
+    }
+    std::vector<mpz_class> result(v.size());
+    for (size_t j = 0; j < v.size(); ++j) {
+        if (!mpz_divisible_p(v[j].get_mpz_t(), weights[j].get_mpz_t())) {
+            throw std::runtime_error("Reduced vector entry " + std::to_string(j)
+                                     + " is not divisible by its column weight");
+        }
+        mpz_divexact(result[j].get_mpz_t(), v[j].get_mpz_t(), weights[j].get_mpz_t());
+    }
+    return result;
+}
+
+std::vector<mpz_class> coppersmith_weights(size_t m, const mpz_class& X) {
+    std::vector<mpz_class> weights(m);
+    mpz_class power = 1;
+    for (size_t j = m; j-- > 0;) {
+        weights[j] = power;
+        power *= X;
+    }
+    return weights;
+}
+
+std::vector<mpz_class> lll(const IntMatrix& B,
+                            const std::vector<mpz_class>& weights,
+                            const Rational& delta,
+                            LLLStats* stats) {
+    IntMatrix reduced = lll1_integral(scale_columns(B, weights), delta, stats);
+    return unscale(reduced[0], weights);
+}
+
+std::vector<mpz_class> lll(const IntMatrix& B,
                             const mpz_class& X,
-                            const Rational& delta) {
-    Rational X_rat(X);
-    Rational X2 = X_rat * X_rat;
+                            const Rational& delta,
+                            LLLStats* stats) {
+    if (B.empty()) {
+        throw std::invalid_argument("Basis must contain at least one vector");
+    }
+    return lll(B, coppersmith_weights(B.cols(), X), delta, stats);
+}
 
-    // Scale the basis
-    std::vector<Vector> scaled(3, Vector(3));
-    for (int i = 0; i < 3; ++i) {
-        scaled[i][0] = X2 * Rational(B[i][0]);
-        scaled[i][1] = X_rat * Rational(B[i][1]);
-        scaled[i][2] = Rational(B[i][2]);
+std::vector<mpz_class> lll_short(const IntMatrix& B,
+                                  const std::vector<mpz_class>& weights,
+                                  const Rational& max_normsq,
+                                  const Rational& delta,
+                                  LLLStats* stats) {
+    IntMatrix scaled = scale_columns(B, weights);
+    size_t row = lll1_integral_until(scaled, max_normsq, delta, stats);
+    return unscale(scaled[row < scaled.rows() ? row : 0], weights);
+}
+
+std::vector<mpz_class> lll_short(const IntMatrix& B,
+                                  const mpz_class& X,
+                                  const Rational& max_normsq,
+                                  const Rational& delta,
+                                  LLLStats* stats) {
+    if (B.empty()) {
+        throw std::invalid_argument("Basis must contain at least one vector");
     }
+    return lll_short(B, coppersmith_weights(B.cols(), X), max_normsq, delta, stats);
+}
 
-    // Run LLL
-    auto reduced = lll1(scaled, delta);
+Rational howgrave_graham_bound(const mpz_class& N, const Rational& beta, size_t dim) {
+    if (beta <= 0 || dim == 0) {
+        throw std::invalid_argument("Need beta > 0 and dim > 0");
+    }
+    // (N^β)² = N^(2a/b) for β = a/b, rounded down so the bound stays safe
+    mpz_class power, root;
+    mpz_pow_ui(power.get_mpz_t(), N.get_mpz_t(), 2 * beta.get_num().get_ui());
+    mpz_root(root.get_mpz_t(), power.get_mpz_t(), beta.get_den().get_ui());
+    return Rational(root, dim);
+}
+
+// ─── Batch LLL ───────────────────────────────────────────────────────────
 
-    // Unscale the first vector
-    Vector v0 = reduced[0];
-    std::vector<mpz_class> result(3);
+std::vector<std::vector<mpz_class>> lll_batch(const std::vector<IntMatrix>& bases,
+                                              const std::vector<mpz_class>& X,
+                                              const Rational& delta,
+                                              size_t threads) {
+    if (bases.size() != X.size()) {
+        throw std::invalid_argument("Need one X value per basis");
+    }
 
-    Rational temp0 = v0[0] / X2;
-    Rational temp1 = v0[1] / X_rat;
+    std::vector<std::vector<mpz_class>> results(bases.size());
+    ThreadPool pool(threads);
 
-    result[0] = temp0.get_num();
-    result[1] = temp1.get_num();
-    result[2] = v0[2].get_num();
+    // Each task reads only its own basis and X and writes only its own
+    // result slot; delta is copied so every thread owns its GMP values.
+    pool.parallel_for(bases.size(), [&](size_t i) {
+        Rational local_delta = delta;
+        results[i] = lll(bases[i], X[i], local_delta);
+    });
 
-    return result;
-}
\ No newline at end of file
+    return results;
+}
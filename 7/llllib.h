@@ -2,70 +2,560 @@
 #define LLLLIB_H
 
 #include <vector>
+#include <string>
+#include <iosfwd>
 #include <gmpxx.h>
+#include "flat_matrix.h"
 
 // Type aliases for clarity
 using Rational = mpq_class;
-using Matrix = std::vector<std::vector<Rational>>;
 using Vector = std::vector<Rational>;
+using Matrix = FlatMatrix<Rational>;
+using IntMatrix = FlatMatrix<mpz_class>;
+using Row = RowView<Rational>;
+using ConstRow = RowView<const Rational>;
+using IntRow = RowView<mpz_class>;
+using ConstIntRow = RowView<const mpz_class>;
 
 // ─── Basic Vector Helpers ────────────────────────────────────────────────
 
 /**
- * Exact dot product of two same-length vectors.
+ * Exact dot product of two same-length vectors (or matrix rows).
  */
-Rational dot(const Vector& u, const Vector& v);
+Rational dot(ConstRow u, ConstRow v);
+
+/**
+ * Exact dot product of two same-length integer vectors (or matrix rows).
+ */
+mpz_class dot(ConstIntRow u, ConstIntRow v);
 
 /**
  * Multiply vector v by scalar c.
  */
-Vector scalar_mult(const Rational& c, const Vector& v);
+Vector scalar_mult(const Rational& c, ConstRow v);
 
 /**
  * Return u − v component-wise.
  */
-Vector vector_sub(const Vector& u, const Vector& v);
+Vector vector_sub(ConstRow u, ConstRow v);
 
 /**
  * Round Rational to nearest integer without float conversion.
  */
 mpz_class frac_round(const Rational& frac);
 
+/**
+ * frac_round into q, reusing q's limbs; used by the reduction loops so
+ * that rounding mu does not allocate.
+ */
+void frac_round(mpz_class& q, const Rational& frac);
+
+// ─── In-Place Row Kernels ────────────────────────────────────────────────
+
+/**
+ * In-place AXPY updates used by the reduction hot loops. They write
+ * straight into the destination row and reuse per-thread scratch values,
+ * so they allocate nothing once the GMP limbs have grown to size.
+ * Integer rows (denominator 1) take a pure mpz_submul fast path.
+ */
+void row_submul(Row row, ConstRow src, const mpz_class& q);   // row −= q·src
+void row_submul(Row row, ConstRow src, const Rational& c);    // row −= c·src
+void row_addmul(Row row, ConstRow src, const Rational& c);    // row += c·src
+void row_submul(IntRow row, ConstIntRow src, const mpz_class& q);
+
+// ─── Common-Denominator Vectors ──────────────────────────────────────────
+
+/**
+ * A rational vector stored as integer numerators over one shared positive
+ * denominator. Arithmetic on it is plain mpz multiply-accumulate, with a
+ * single normalisation at the end instead of a gcd per entry.
+ */
+struct CommonDenVector {
+    std::vector<mpz_class> num;
+    mpz_class den = 1;
+};
+
+/**
+ * Convert a rational row, using the lcm of its denominators.
+ */
+CommonDenVector to_common_den(ConstRow v);
+
+/**
+ * Write entries [first, first + out.size()) of v back as canonical
+ * Rationals into out; with first = 0 and out as long as v, the whole
+ * vector. gram_schmidt converts its B* rows this way, one column chunk
+ * per thread.
+ */
+void to_rational(const CommonDenVector& v, Row out, size_t first = 0);
+
+/**
+ * Divide the numerators and the denominator by their common gcd.
+ */
+void normalize(CommonDenVector& v);
+
+/**
+ * Exact dot product: one integer multiply-accumulate over the numerators
+ * and one canonicalisation of the result.
+ */
+Rational dot(const CommonDenVector& u, const CommonDenVector& v);
+
 // ─── Gram–Schmidt + LLL ──────────────────────────────────────────────────
 
 /**
- * Gram–Schmidt orthogonalization for a 3-vector basis B.
+ * Gram–Schmidt orthogonalization for an n-vector basis B.
  * Returns tuple of (mu, B*, normsquared) with exact Rationals.
+ * mu is n×n and B* is n×m; both are move-only flat matrices.
+ * Internally the rows of B and B* are kept as CommonDenVectors, so only
+ * the final outputs pay for per-entry normalisation.
  */
 struct GramSchmidtResult {
     Matrix mu;
-    std::vector<Vector> Bstar;
+    Matrix Bstar;
     Vector normsq;
 };
 
-GramSchmidtResult gram_schmidt(const std::vector<Vector>& B);
+GramSchmidtResult gram_schmidt(const Matrix& B);
+
+// Instrumentation is compiled in unless the build sets LLLLIB_STATS=0
+// (CMake option LLL_STATS); without it LLLStats is never written to.
+#ifndef LLLLIB_STATS
+#define LLLLIB_STATS 1
+#endif
+
+/**
+ * Instrumentation filled by lll1 (and everything built on it) when a
+ * non-null pointer is passed. Counts and timers accumulate across calls.
+ *
+ * mpq_ops counts rational multiplications, additions, subtractions and
+ * divisions done by the reduction itself (a fused row update of length m
+ * is 2m operations). Bit lengths are sampled from every basis row and mu
+ * row after size reduction and from the norms and mu_{k,k-1} after a swap.
+ */
+struct LLLStats {
+    size_t size_reductions = 0;      // non-zero q applied to a row
+    size_t swaps = 0;                // Lovász failures / adjacent swaps
+    size_t lovasz_tests = 0;
+    size_t gso_recomputations = 0;   // full gram_schmidt runs
+    size_t mpq_ops = 0;
+
+    double gso_seconds = 0;          // wall-clock time per phase
+    double size_reduction_seconds = 0;
+    double lovasz_seconds = 0;
+    double swap_seconds = 0;
+
+    size_t max_num_bits = 0;         // largest numerator / denominator seen
+    size_t max_den_bits = 0;
+
+    std::ostream* trace = nullptr;   // one JSON object per line per swap, if set
+};
+
+/**
+ * Write stats as a single-line JSON object (without the trace pointer).
+ */
+void write_stats_json(std::ostream& os, const LLLStats& stats);
 
 /**
- * 3-dimensional LLL reduction using exact Rationals.
+ * LLL reduction of an n-vector basis using exact Rationals.
  *
- * @param B 3×3 basis – each inner vector is a lattice vector length 3.
+ * @param B n×m basis – each row is a lattice vector of length m, and the
+ *          n rows must be linearly independent (n ≤ m). Pass B.clone()
+ *          to keep the caller's copy.
  * @param delta Lovász parameter (default 0.9999 ≈ very strong reduction).
+ * @param stats Optional counters, updated during reduction.
  * @return LLL-reduced basis (not necessarily shortest first).
  */
-std::vector<Vector> lll1(std::vector<Vector> B, const Rational& delta = Rational(9999, 10000));
+Matrix lll1(Matrix B, const Rational& delta = Rational(9999, 10000),
+            LLLStats* stats = nullptr);
 
 /**
- * Apply diagonal scaling diag(X², X, 1) to a 3×3 basis, run LLL,
- * then unscale the first vector so its coordinates are:
- *     [v0 / X²,  v1 / X,  v2]
+ * lll1 with the row updates of every step split across a thread pool:
+ * the initial Gram–Schmidt columns, the basis and mu entries touched by
+ * size reduction, and the B* columns and mu rows updated by a swap. Each
+ * element is still computed exactly and by one thread only, so the result
+ * is bit-identical to lll1. Pays off once rows hold dozens of multi-limb
+ * entries; short rows are left on the calling thread.
  *
- * @param B 3×3 integer matrix [[a,b,c], [d,e,f], [g,h,i]].
+ * @param B n×m basis with linearly independent rows.
+ * @param threads Worker threads including the caller (0 = one per core).
+ * @param delta Lovász parameter (default 0.9999).
+ * @param stats Optional counters, updated during reduction.
+ * @return The same reduced basis as lll1(B, delta).
+ */
+Matrix lll1_parallel(Matrix B, size_t threads = 0,
+                     const Rational& delta = Rational(9999, 10000),
+                     LLLStats* stats = nullptr);
+
+/**
+ * The lll1 loop on a basis whose GSO is already known. B and gs are
+ * reduced together, so afterwards gs is still the exact GSO of B and
+ * callers (BKZ, deep insertion) can keep using it without recomputing.
+ *
+ * @param B n×m basis with canonical Rationals.
+ * @param gs gram_schmidt(B), updated in place.
+ * @param delta Lovász parameter.
+ * @param stats Optional counters, updated during reduction.
+ */
+void lll1_in_place(Matrix& B, GramSchmidtResult& gs, const Rational& delta,
+                   LLLStats* stats = nullptr);
+
+/**
+ * Deep-insertion LLL (Schnorr–Euchner). After size-reducing b_k, it is
+ * compared against every earlier projected position: b_k is inserted at
+ * the first i with ||π_i(b_k)||² < delta·||b*_i||². Insertion is a chain of
+ * adjacent swaps that update the GramSchmidtResult incrementally.
+ *
+ * @param B n×m basis with linearly independent rows.
+ * @param depth Only positions i with k − i ≤ depth are tried; 0 means
+ *              unlimited, and 1 gives exactly the same result as lll1.
+ * @param delta Lovász parameter (default 0.9999).
+ * @return Deep-LLL-reduced basis.
+ */
+Matrix lll_deep(Matrix B, size_t depth = 0, const Rational& delta = Rational(9999, 10000));
+
+/**
+ * Segment LLL for large dimensions. Rows are split into segments of
+ * segment_size consecutive vectors, and each segment is LLL-reduced
+ * locally (and concurrently) on its part of the GSO. Phases alternate
+ * between two segment grids offset by half a segment, with the GSO
+ * entries between segments refreshed after each phase, until neither
+ * grid changes. A final lll1 pass over the whole basis then guarantees
+ * the same size-reduction and Lovász conditions as lll1, although the
+ * basis itself may differ.
+ *
+ * @param B n×m basis with linearly independent rows.
+ * @param segment_size Rows per segment (0 = automatic, 4 to 16).
+ * @param threads Worker threads including the caller (0 = one per core).
+ * @param delta Lovász parameter (default 0.9999).
+ * @return LLL-reduced basis.
+ */
+Matrix lll_segment(Matrix B, size_t segment_size = 0, size_t threads = 0,
+                   const Rational& delta = Rational(9999, 10000));
+
+/**
+ * B with column j multiplied by weights[j]; the result is still an
+ * integer basis.
+ * @throws std::invalid_argument if B is empty, its width differs from
+ *         weights.size(), or a weight is zero.
+ */
+IntMatrix scale_columns(const IntMatrix& B, const std::vector<mpz_class>& weights);
+
+/**
+ * Undo scale_columns on one row: entry j divided exactly by weights[j].
+ * @throws std::invalid_argument on a length mismatch.
+ * @throws std::runtime_error if an entry is not divisible by its weight.
+ */
+std::vector<mpz_class> unscale(ConstIntRow v, const std::vector<mpz_class>& weights);
+
+/**
+ * Coppersmith weights for m columns, highest degree first: column j
+ * holds the coefficient of x^(m-1-j) and gets X^(m-1-j).
+ */
+std::vector<mpz_class> coppersmith_weights(size_t m, const mpz_class& X);
+
+/**
+ * Apply the diagonal column scaling diag(w_0, ..., w_{m-1}) to an n×m
+ * basis, run LLL, then unscale the first vector so its coordinates are:
+ *     [v0 / w_0,  v1 / w_1,  ...,  v_{m-1} / w_{m-1}]
+ *
+ * The scaled basis stays integral and is reduced with lll1_integral, so
+ * no Rational is involved; the result is the same as lll1 would give.
+ * Every reduced vector lies in the scaled lattice, so the divisions are
+ * exact, and they are checked.
+ *
+ * @param B n×m integer matrix, one lattice vector per row.
+ * @param weights Column weights w_j (must be non-zero, length m).
+ * @param delta Lovász parameter (default 0.9999).
+ * @param stats Optional counters for the underlying lll1_integral run.
+ * @return The first vector of the reduced basis, unscaled as integers.
+ * @throws std::invalid_argument if a weight is zero.
+ * @throws std::runtime_error if an entry is not divisible by its weight.
+ */
+std::vector<mpz_class> lll(const IntMatrix& B,
+                            const std::vector<mpz_class>& weights,
+                            const Rational& delta = Rational(9999, 10000),
+                            LLLStats* stats = nullptr);
+
+/**
+ * Coppersmith scaling: column j of an n×m basis holds the coefficient of
+ * x^(m-1-j), so it is scaled by X^(m-1-j). For m = 3 this is the classic
+ * diag(X², X, 1).
+ *
+ * @param B n×m integer matrix, highest-degree coefficient first.
  * @param X Scaling parameter (e.g. the small-root bound in Coppersmith).
  * @param delta Lovász parameter (default 0.9999).
+ * @param stats Optional counters for the underlying lll1_integral run.
  * @return The first vector of the reduced basis, unscaled as integers.
  */
-std::vector<mpz_class> lll(const std::vector<std::vector<mpz_class>>& B,
+std::vector<mpz_class> lll(const IntMatrix& B,
                             const mpz_class& X,
-                            const Rational& delta = Rational(9999, 10000));
+                            const Rational& delta = Rational(9999, 10000),
+                            LLLStats* stats = nullptr);
+
+/**
+ * Early-exit variant of lll(B, weights): reduction stops as soon as some
+ * row of the scaled basis has squared norm below max_normsq, and that row
+ * is returned unscaled. Each size-reduced row is tested once, and the
+ * exact O(m) norm is only computed when ||b*_k||² is already below the
+ * bound. If no row ever qualifies the result is that of lll().
+ *
+ * For Coppersmith, max_normsq is the Howgrave-Graham bound on the scaled
+ * polynomial, see howgrave_graham_bound.
+ *
+ * @param B n×m integer matrix, one lattice vector per row.
+ * @param weights Column weights w_j (must be non-zero, length m).
+ * @param max_normsq Stop once a scaled row has ||b||² < max_normsq.
+ * @param delta Lovász parameter (default 0.9999).
+ * @param stats Optional counters for the underlying reduction.
+ * @return The first qualifying row (or the first reduced row), unscaled.
+ */
+std::vector<mpz_class> lll_short(const IntMatrix& B,
+                                  const std::vector<mpz_class>& weights,
+                                  const Rational& max_normsq,
+                                  const Rational& delta = Rational(9999, 10000),
+                                  LLLStats* stats = nullptr);
+
+/**
+ * lll_short with Coppersmith scaling: column j is weighted by X^(m-1-j).
+ */
+std::vector<mpz_class> lll_short(const IntMatrix& B,
+                                  const mpz_class& X,
+                                  const Rational& max_normsq,
+                                  const Rational& delta = Rational(9999, 10000),
+                                  LLLStats* stats = nullptr);
+
+/**
+ * Squared Howgrave-Graham bound (N^β)² / dim, rounded down. A polynomial
+ * whose scaled coefficient vector is shorter than this has its small
+ * roots modulo a divisor b ≥ N^β over the integers as well.
+ *
+ * @param N Modulus the lattice polynomials vanish modulo (N^m when the
+ *          lattice is built from m-th powers).
+ * @param beta Exponent β = a/b > 0 (e.g. 1/2 for a factor of an RSA N).
+ * @param dim Lattice dimension (number of polynomial coefficients).
+ * @return floor(N^(2β)) / dim.
+ */
+Rational howgrave_graham_bound(const mpz_class& N, const Rational& beta, size_t dim);
+
+/**
+ * Integral LLL (de Weger / Cohen) on an integer basis. Only the Gram
+ * determinants d_i and the scaled coefficients λ_ij = d_j·μ_ij are kept,
+ * all as mpz_class updated with exact divisions, so no rational is ever
+ * normalised. Uses the same step order and rounding as lll1, so for an
+ * integer input it returns exactly the same basis.
+ *
+ * @param B n×m integer basis with linearly independent rows.
+ * @param delta Lovász parameter (default 0.9999).
+ * @param stats Optional counters; mpq_ops stays 0 and max_den_bits
+ *        unchanged, since every quantity is an integer.
+ * @return LLL-reduced integer basis.
+ */
+IntMatrix lll1_integral(IntMatrix B,
+                        const Rational& delta = Rational(9999, 10000),
+                        LLLStats* stats = nullptr);
+
+/**
+ * Early-exit lll1_integral: B is reduced in place until some size-reduced
+ * row has ||b||² < max_normsq, with the same steps as lll_short.
+ *
+ * @param B n×m integer basis with linearly independent rows.
+ * @param max_normsq Stop once a row has ||b||² < max_normsq.
+ * @param delta Lovász parameter (default 0.9999).
+ * @param stats Optional counters for the reduction.
+ * @return Index of the qualifying row, or n if no row ever qualified (B is
+ *         then fully reduced).
+ */
+size_t lll1_integral_until(IntMatrix& B, const Rational& max_normsq,
+                           const Rational& delta = Rational(9999, 10000),
+                           LLLStats* stats = nullptr);
+
+/**
+ * LLL on a lattice given only by its exact Gram matrix G = B·Bᵀ. The
+ * basis coordinates are never needed: every size reduction and swap is
+ * applied to the transformation instead, so each step costs O(n) no
+ * matter how wide or large the original rows are. U·B is exactly
+ * lll1_integral(B, delta), and U[0] holds the coefficients of the short
+ * first vector.
+ *
+ * @param G n×n symmetric positive definite integer Gram matrix.
+ * @param delta Lovász parameter (default 0.9999).
+ * @return The n×n unimodular transformation U.
+ */
+IntMatrix lll_gram(const IntMatrix& G,
+                   const Rational& delta = Rational(9999, 10000));
+
+// ─── Checkpointing ───────────────────────────────────────────────────────
+
+/**
+ * Where and how often a long reduction saves its state. An empty path
+ * disables checkpointing. The clock is read once per loop iteration, and
+ * the file (whose size is that of the basis) is written at most once per
+ * interval, so the overhead is bounded by the interval.
+ */
+struct CheckpointParams {
+    std::string path;
+    double interval_seconds = 60;
+};
+
+/**
+ * Everything needed to continue a reduction: the current basis, the
+ * lll1 loop index k (rows before k are already LLL-reduced) and the delta
+ * of the run, plus, for BKZ, the position in the tour. The GSO is not
+ * stored; it is a function of the basis and is recomputed on resume.
+ */
+struct CheckpointState {
+    std::string algorithm = "lll1";   // "lll1" or "bkz"
+    Matrix basis;
+    size_t k = 1;
+    Rational delta = Rational(9999, 10000);
+
+    // BKZ only
+    size_t block_size = 0;
+    size_t tour = 0;                  // 0 = still in the LLL preprocessing
+    size_t j = 0;                     // next block start in the tour
+    bool changed = false;             // whether the tour has changed B yet
+    Vector tour_norms;
+};
+
+/**
+ * Write a checkpoint to path + ".tmp" and rename it over path, so the
+ * file at path is always either the previous or the new complete state.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void write_checkpoint(const std::string& path, const CheckpointState& state);
+
+/**
+ * Read a checkpoint written by write_checkpoint. Sizes and loop positions
+ * are checked against the file and the basis before anything is
+ * allocated for them.
+ * @throws std::runtime_error if the file is missing or malformed.
+ */
+CheckpointState read_checkpoint(const std::string& path);
+
+/**
+ * lll1 that saves its basis and loop index to checkpoint.path every
+ * checkpoint.interval_seconds. The file is removed once the reduction
+ * has finished. The result is the same as lll1(B, delta).
+ */
+Matrix lll1_checkpointed(Matrix B, const CheckpointParams& checkpoint,
+                         const Rational& delta = Rational(9999, 10000),
+                         LLLStats* stats = nullptr);
+
+/**
+ * Continue an lll1_checkpointed run from checkpoint.path, writing further
+ * checkpoints to the same file. delta must be that of the original run.
+ * @throws std::runtime_error if the file is unreadable,
+ *         std::invalid_argument if it is not an lll1 checkpoint or was
+ *         written with a different delta.
+ */
+Matrix lll1_resume(const CheckpointParams& checkpoint,
+                   const Rational& delta = Rational(9999, 10000),
+                   LLLStats* stats = nullptr);
+
+// ─── BKZ Block Reduction ─────────────────────────────────────────────────
+
+/**
+ * BKZ parameters.
+ *
+ * pruning selects linear pruning of the enumeration tree: at a level with
+ * l of the block's d coordinates fixed, the partial norm must stay below
+ * R²·(1 − pruning·(1 − l/d)). 0 enumerates the whole ball (exact SVP),
+ * 1 is full linear pruning.
+ */
+struct BKZParams {
+    size_t block_size = 10;
+    Rational delta = Rational(9999, 10000);
+    double pruning = 0.0;
+    size_t max_tours = 0;        // 0 = run until a tour changes nothing
+    bool early_abort = true;     // stop once a tour does not shorten b_0
+    std::ostream* progress = nullptr;   // per-tour report, if set
+    CheckpointParams checkpoint;        // periodic state file, if a path is set
+};
+
+/**
+ * Result of bkz: the reduced basis and ||b_0||² after the initial LLL
+ * (tour_norms[0]) and after each BKZ tour.
+ */
+struct BKZResult {
+    Matrix basis;
+    Vector tour_norms;
+};
+
+/**
+ * BKZ reduction: lll1 preprocessing, then tours over blocks
+ * [j, j + block_size). Each block's projected lattice is searched for a
+ * vector shorter than delta·||b*_j||² with a pruned Schnorr–Euchner
+ * enumeration; a hit is inserted with a unimodular row transformation
+ * and the basis is cleaned up with lll1_in_place.
+ *
+ * With params.checkpoint.path set, the state is saved periodically during
+ * the preprocessing and before each block, and the file is removed at the
+ * end; see bkz_resume.
+ *
+ * @param B n×m basis with linearly independent rows.
+ * @param params Block size, pruning, tour limits, reporting and checkpoints.
+ * @return Reduced basis plus the per-tour first-vector norms.
+ */
+BKZResult bkz(Matrix B, const BKZParams& params = BKZParams());
+
+/**
+ * Continue a bkz run from params.checkpoint.path: the LLL preprocessing
+ * from its loop index, or the tour from its next block. params must match
+ * the original run (the block size and delta are checked).
+ * @throws std::runtime_error if the file is unreadable,
+ *         std::invalid_argument if it is not a BKZ checkpoint with
+ *         params.block_size and params.delta.
+ */
+BKZResult bkz_resume(const BKZParams& params);
+
+// ─── Batch LLL ───────────────────────────────────────────────────────────
+
+/**
+ * Run the Coppersmith-scaled lll(B, X, delta) on many independent bases
+ * in parallel. Work is handed out dynamically to a thread pool, and the
+ * row kernels use per-thread scratch, so no GMP object is shared between
+ * threads.
+ *
+ * @param bases Independent integer bases.
+ * @param X One scaling parameter per basis.
+ * @param delta Lovász parameter (default 0.9999).
+ * @param threads Worker threads including the caller (0 = one per core).
+ * @return The unscaled first vector of each reduced basis, in input order.
+ */
+std::vector<std::vector<mpz_class>> lll_batch(const std::vector<IntMatrix>& bases,
+                                              const std::vector<mpz_class>& X,
+                                              const Rational& delta = Rational(9999, 10000),
+                                              size_t threads = 0);
+
+// ─── Floating-Point LLL (L²) ─────────────────────────────────────────────
+
+/**
+ * Floating-point type used for the approximate Gram–Schmidt data in lll_fp.
+ * Auto picks the cheapest type with enough precision and exponent range
+ * for the input; every choice is escalated automatically on instability.
+ */
+enum class FloatType {
+    Auto,
+    Double,
+    LongDouble,
+    MultiPrecision   // GMP mpf_class, precision doubled on each retry
+};
+
+/**
+ * L²-style (Nguyen–Stehlé) LLL reduction. The basis and its Gram matrix
+ * stay exact integers while the Gram–Schmidt coefficients are computed in
+ * floating point. If the approximation becomes unstable, precision is
+ * raised (double → long double → mpf) and reduction resumes from the
+ * current basis. A final exact pass through lll1_integral certifies the
+ * result, so it satisfies the same size-reduction and Lovász conditions
+ * as lll1.
+ *
+ * @param B n×m integer basis with linearly independent rows.
+ * @param delta Lovász parameter (default 0.9999).
+ * @param start Floating-point type to start with (default Auto).
+ * @return LLL-reduced integer basis.
+ */
+IntMatrix lll_fp(IntMatrix B,
+                 const Rational& delta = Rational(9999, 10000),
+                 FloatType start = FloatType::Auto);
 
 #endif // LLLLIB_H
\ No newline at end of file
@@ -3,6 +3,11 @@
 #include <sstream>
 #include <gmpxx.h>
 #include "llllib.h"
+#include "codec.h"
+#include "coppersmith.h"
+#include "lattice_io.h"
+#include "rsa.h"
+#include "rsa_pipeline.h"
 using namespace std;
 
 //TASK 1 is verified using lll.cpp
@@ -56,7 +61,104 @@ txtFile readLabFile(const string& filename) {
 
     return data;
 }
-int main() {
+int usage() {
+    cerr << "Usage: lab7 [<ciphertexts> [decimal|hex|base64]]\n"
+         << "       lab7 --batch <records> [--threads t] [--window w]\n"
+         << "       lab7 --pack <records.txt> <records.bin>\n";
+    return 1;
+}
+
+// lab7 --batch <file> [--threads t] [--window w]: one CSV line per record
+// on stdout, per-stage throughput on stderr. The file is either record text
+// or a binary record table (see lattice_io.h).
+int runBatch(int argc, char** argv) {
+    string filename = argv[2];
+    PipelineOptions options;
+    for (int i = 3; i < argc; i += 2) {
+        string flag = argv[i];
+        size_t* target = flag == "--threads" ? &options.threads
+                       : flag == "--window" ? &options.window
+                       : nullptr;
+        if (!target) {
+            cerr << "Unknown option " << flag << "\n";
+            return usage();
+        }
+        if (i + 1 == argc) {
+            cerr << "Missing value for " << flag << "\n";
+            return usage();
+        }
+        string value = argv[i + 1];
+        try {
+            if (value.empty() || value.find_first_not_of("0123456789") != string::npos) {
+                throw invalid_argument(value);
+            }
+            *target = stoul(value);
+        } catch (const exception&) {
+            cerr << "Invalid value for " << flag << ": " << value << "\n";
+            return usage();
+        }
+    }
+
+    try {
+        PipelineStats stats;
+        if (is_table_file(filename)) {
+            // Binary record table: records are decoded straight from the mapping
+            MappedTable table(filename);
+            size_t row = 0;
+            stats = run_pipeline([&](RSARecord& record) {
+                if (row == table.rows()) return false;
+                record = read_record(table, row++);
+                return true;
+            }, cout, options);
+        } else {
+            ifstream file(filename);
+            if (!file.is_open()) {
+                throw runtime_error("Could not open file: " + filename);
+            }
+            stats = run_pipeline(file, cout, options);
+        }
+        write_pipeline_stats(cerr, stats);
+        return stats.failures == 0 ? 0 : 1;
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+// lab7 --pack <records.txt> <records.bin>: convert record text to a binary table
+int packRecords(const string& input, const string& output) {
+    ifstream file(input);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open file: " << input << "\n";
+        return 1;
+    }
+    try {
+        RecordReader reader(file);
+        vector<RSARecord> records;
+        RSARecord record;
+        while (reader.next(record)) {
+            records.push_back(record);
+        }
+        write_record_file(output, records);
+        cout << "Packed " << records.size() << " records into " << output << "\n";
+        return 0;
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && string(argv[1]).compare(0, 2, "--") == 0) {
+        string mode = argv[1];
+        if (mode == "--batch" && argc >= 3) return runBatch(argc, argv);
+        if (mode == "--pack" && argc == 4) return packRecords(argv[2], argv[3]);
+        return usage();
+    }
+    if (argc > 3) {
+        return usage();
+    }
+
     cout << "Task 1 - Run lll.cpp";
     cout << "\n\nTask 2\nReading File\n";
     txtFile data = readLabFile("lab07-2.txt");
@@ -69,7 +171,7 @@ int main() {
     mpz_class p0_squared = data.p0 * data.p0;
     cout << "p0_squared = " << p0_squared << "\n";
 
-    vector<vector<mpz_class>> M= {
+    IntMatrix M = {
         {mpz_class(1), 2 * data.p0, p0_squared},
         {mpz_class(0), data.n, mpz_class(0)},
         {mpz_class(0), mpz_class(0), data.n}
@@ -84,43 +186,27 @@ int main() {
     cout << "b_coef = " << b_coef << "\n";
     cout << "c_coef = " << c_coef << "\n";
 
-    mpz_class x1;
-    mpz_class x2;
-
-    if (a_coef == 0) {
-        cout << "Linear equation detected\n";
-        x1 = -c_coef / b_coef;
-        x2 = x1;
-    } else {
-        cout << "Quadratic equation detected\n";
-        mpz_class discriminant = b_coef * b_coef - 4 * a_coef * c_coef;
-
-        mpz_class sqrt_disc;
-        mpz_sqrt(sqrt_disc.get_mpz_t(), discriminant.get_mpz_t());
-
-        x1 = (-b_coef + sqrt_disc) / (2 * a_coef);
-        x2 = (-b_coef - sqrt_disc) / (2 * a_coef);
-    }
-
-    cout << "x1 = " << x1 << "\n";
-    cout << "x2 = " << x2 << "\n";
+    // The short vector is a polynomial a·x² + b·x + c with the small root x0
+    Polynomial h{c_coef, b_coef, a_coef};
+    vector<mpz_class> roots = integer_roots(h, data.X);
+    cout << "Integer roots with |x| <= X: " << roots.size() << "\n";
 
     mpz_class p;
     mpz_class q;
-    mpz_class p1 = data.p0 + x1;
-    mpz_class p2 = data.p0 + x2;
 
     cout << "\nTesting solutions...\n";
-    if (data.n % p1 == 0) {
-        p = p1;
-        q = data.n / p;
-        cout << "Found p using x1!\n";
-    } else if (data.n % p2 == 0) {
-        p = p2;
-        q = data.n / p;
-        cout << "Found p using x2!\n";
-    } else {
-        cout << "Error: Neither solution worked!\n";
+    for (const auto& x : roots) {
+        cout << "x = " << x << "\n";
+        mpz_class candidate = data.p0 + x;
+        if (candidate > 1 && data.n % candidate == 0) {
+            p = candidate;
+            q = data.n / p;
+            cout << "Found p using x = " << x << "!\n";
+            break;
+        }
+    }
+    if (p == 0) {
+        cout << "Error: No root gave a factor of n!\n";
         return 1;
     }
 
@@ -134,6 +220,27 @@ int main() {
     mpz_invert(e.get_mpz_t(), data.d.get_mpz_t(), phi_n.get_mpz_t()); //COMPUTES INVERSE MOD (a^-1 mod m)
     cout << "Private key e = " << e << endl;
     cout << "\n\nTask 4: \n\n";
+    // Two half-size exponentiations mod p and q, recombined with Garner
+    DecryptService service;
+    const CRTKey& key = service.key(p, q, e);
+
+    // lab7 <ciphertexts> [decimal|hex|base64]: decrypt one ciphertext per line
+    if (argc >= 2) {
+        try {
+            ifstream file(argv[1]);
+            if (!file.is_open()) {
+                throw runtime_error("Could not open file: " + string(argv[1]));
+            }
+            IntegerReader reader(file, argc >= 3 ? parse_encoding(argv[2]) : Encoding::Decimal);
+            size_t count = service.decrypt_stream(key, reader, cout);
+            cout << "\nDecrypted " << count << " ciphertexts from " << argv[1] << "\n";
+            return 0;
+        } catch (const exception& ex) {
+            cerr << "Error: " << ex.what() << "\n";
+            return 1;
+        }
+    }
+
     string ciphertext =
     "1347109129531723028124112099668773654304403275978770987077622835039"
     "476263200052469838716773837201990422887230376844673118639664946920257"
@@ -146,24 +253,11 @@ int main() {
     "08754188918114070811605644462955226763175079872803044435";
 
     mpz_class c(ciphertext);
-
-    mpz_class m;
-    mpz_powm(m.get_mpz_t(), c.get_mpz_t(), e.get_mpz_t(), data.n.get_mpz_t());
+    mpz_class m = crt_decrypt(key, c);
 
     cout << "Decrypted Message (int format) " << m << "\n\n";
 
-    string message;
-    mpz_class temp = m;
-
-    while (temp > 0) {
-        mpz_class remainder = temp % 256;
-        char ch = static_cast<char>(remainder.get_ui()); //GETUI CONVERTD MPZ CLASS TO UNSIGNED LONG INT FOR VAL GREATER THAN 256
-
-        message = ch + message;
-
-        temp /= 256;
-
-    }
+    string message = to_text(m);
 
     cout << "Decoded Message:\n " << message << "\n";
     if (message == "ALICE, THIS IS BOB. PLEASE GENERATE NEW PRIMES FOR YOUR RSA") {
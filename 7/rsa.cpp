@@ -0,0 +1,93 @@
+#include "rsa.h"
+#include <stdexcept>
+
+// ─── CRT Decryption ──────────────────────────────────────────────────────
+
+CRTKey make_crt_key(const mpz_class& p, const mpz_class& q, const mpz_class& e) {
+    if (p < 2 || q < 2) {
+        throw std::invalid_argument("CRT primes must be at least 2");
+    }
+    if (e < 1) {
+        throw std::invalid_argument("Private exponent must be at least 1");
+    }
+
+    CRTKey key;
+    key.n = p * q;
+    key.p = p;
+    key.q = q;
+
+    mpz_class p1 = p - 1;
+    mpz_class q1 = q - 1;
+    mpz_fdiv_r(key.ep.get_mpz_t(), e.get_mpz_t(), p1.get_mpz_t());
+    mpz_fdiv_r(key.eq.get_mpz_t(), e.get_mpz_t(), q1.get_mpz_t());
+    if (mpz_invert(key.q_inv.get_mpz_t(), q.get_mpz_t(), p.get_mpz_t()) == 0) {
+        throw std::invalid_argument("q is not invertible modulo p");
+    }
+    return key;
+}
+
+mpz_class crt_decrypt(const CRTKey& key, const mpz_class& c) {
+    if (c < 0 || c >= key.n) {
+        throw std::invalid_argument("Ciphertext must lie in [0, n)");
+    }
+
+    mpz_class mp, mq;
+    mpz_fdiv_r(mp.get_mpz_t(), c.get_mpz_t(), key.p.get_mpz_t());
+    mpz_fdiv_r(mq.get_mpz_t(), c.get_mpz_t(), key.q.get_mpz_t());
+    // A zero residue stays zero since e ≥ 1, even when e mod (p − 1) is 0
+    // and mpz_powm would return 0^0 = 1
+    if (mp != 0) mpz_powm(mp.get_mpz_t(), mp.get_mpz_t(), key.ep.get_mpz_t(), key.p.get_mpz_t());
+    if (mq != 0) mpz_powm(mq.get_mpz_t(), mq.get_mpz_t(), key.eq.get_mpz_t(), key.q.get_mpz_t());
+
+    // Garner: h = (m_p − m_q)·q⁻¹ mod p, m = m_q + h·q
+    mpz_class h = mp - mq;
+    h *= key.q_inv;
+    mpz_fdiv_r(h.get_mpz_t(), h.get_mpz_t(), key.p.get_mpz_t());
+    mpz_class m = mq;
+    mpz_addmul(m.get_mpz_t(), h.get_mpz_t(), key.q.get_mpz_t());
+    return m;
+}
+
+// ─── Batch Decryption ────────────────────────────────────────────────────
+
+const CRTKey& DecryptService::key(const mpz_class& p, const mpz_class& q, const mpz_class& e) {
+    std::pair<mpz_class, mpz_class> id(p * q, e);
+    auto it = keys_.find(id);
+    if (it == keys_.end()) {
+        it = keys_.emplace(std::move(id), make_crt_key(p, q, e)).first;
+    }
+    return it->second;
+}
+
+std::vector<mpz_class> DecryptService::decrypt(const CRTKey& key, const std::vector<mpz_class>& ciphertexts) {
+    std::vector<mpz_class> plaintexts(ciphertexts.size());
+    pool_.parallel_for(ciphertexts.size(), [&](size_t i) {
+        plaintexts[i] = crt_decrypt(key, ciphertexts[i]);
+    });
+    return plaintexts;
+}
+
+size_t DecryptService::decrypt_stream(const CRTKey& key, IntegerReader& in, std::ostream& out,
+                                      Encoding encoding, size_t window) {
+    if (window == 0) window = 16 * pool_.size();
+
+    std::vector<mpz_class> ciphertexts;
+    size_t total = 0;
+    bool more = true;
+    while (more) {
+        ciphertexts.clear();
+        mpz_class c;
+        while (ciphertexts.size() < window && (more = in.next(c))) {
+            ciphertexts.push_back(c);
+        }
+        if (ciphertexts.empty()) break;
+
+        for (const auto& m : decrypt(key, ciphertexts)) {
+            write_integer(out, m, encoding);
+            out << '\n';
+        }
+        out.flush();
+        total += ciphertexts.size();
+    }
+    return total;
+}
@@ -0,0 +1,104 @@
+#ifndef RSA_H
+#define RSA_H
+
+#include <map>
+#include <ostream>
+#include <utility>
+#include <vector>
+#include <gmpxx.h>
+#include "codec.h"
+#include "thread_pool.h"
+
+// Throughout the lab d is the public and e the private exponent.
+
+// ─── CRT Decryption ──────────────────────────────────────────────────────
+
+/**
+ * Private key in CRT form. Decryption with it costs two exponentiations
+ * modulo p and q with half-size exponents instead of one modulo n, about
+ * a quarter of the work per ciphertext.
+ */
+struct CRTKey {
+    mpz_class n;
+    mpz_class p;
+    mpz_class q;
+    mpz_class ep;       // e mod (p − 1)
+    mpz_class eq;       // e mod (q − 1)
+    mpz_class q_inv;    // q⁻¹ mod p
+};
+
+/**
+ * Precompute the CRT form of the private exponent e for n = p·q.
+ *
+ * @param p, q Distinct primes.
+ * @param e Private exponent (≥ 1).
+ * @return The key with n = p·q.
+ * @throws std::invalid_argument if p or q is below 2, e is below 1, or q
+ *         is not invertible modulo p.
+ */
+CRTKey make_crt_key(const mpz_class& p, const mpz_class& q, const mpz_class& e);
+
+/**
+ * m = c^e mod n from m_p = c^ep mod p and m_q = c^eq mod q, recombined
+ * with Garner's formula m = m_q + q·((m_p − m_q)·q⁻¹ mod p).
+ *
+ * @param key Precomputed key.
+ * @param c Ciphertext, 0 ≤ c < n.
+ * @return The plaintext as an integer.
+ * @throws std::invalid_argument if c is out of range.
+ */
+mpz_class crt_decrypt(const CRTKey& key, const mpz_class& c);
+
+// ─── Batch Decryption ────────────────────────────────────────────────────
+
+/**
+ * Decrypts many ciphertexts under recovered keys. CRT keys are built once
+ * per (n, e) and cached for the lifetime of the service, and ciphertexts
+ * are spread over a ThreadPool. key() must not be called concurrently
+ * with itself; the decrypt calls only read the keys.
+ */
+class DecryptService {
+public:
+    /**
+     * @param threads Total threads including the caller (0 = one per core).
+     */
+    explicit DecryptService(size_t threads = 0) : pool_(threads) {}
+
+    /**
+     * Cached CRT key for n = p·q and private exponent e. The reference
+     * stays valid as long as the service.
+     * @throws std::invalid_argument as make_crt_key.
+     */
+    const CRTKey& key(const mpz_class& p, const mpz_class& q, const mpz_class& e);
+
+    /**
+     * Number of distinct keys built so far.
+     */
+    size_t cached_keys() const { return keys_.size(); }
+
+    /**
+     * Plaintexts of all ciphertexts, in order.
+     * @throws std::invalid_argument if a ciphertext is outside [0, n).
+     */
+    std::vector<mpz_class> decrypt(const CRTKey& key, const std::vector<mpz_class>& ciphertexts);
+
+    /**
+     * Decrypt every ciphertext of a stream and write each plaintext,
+     * followed by a newline, in the given encoding. Ciphertexts are read
+     * and decrypted a window at a time and every window is flushed before
+     * the next is read, so memory use does not depend on the stream length.
+     *
+     * @param window Ciphertexts in flight (0 = 16 per thread).
+     * @return Number of ciphertexts decrypted.
+     * @throws std::runtime_error on a malformed line, std::invalid_argument
+     *         if a ciphertext is outside [0, n).
+     */
+    size_t decrypt_stream(const CRTKey& key, IntegerReader& in, std::ostream& out,
+                          Encoding encoding = Encoding::Text, size_t window = 0);
+
+private:
+    ThreadPool pool_;
+    std::map<std::pair<mpz_class, mpz_class>, CRTKey> keys_;   // (n, e) → key
+};
+
+#endif // RSA_H
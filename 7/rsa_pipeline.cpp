@@ -0,0 +1,251 @@
+#include "rsa_pipeline.h"
+#include "coppersmith.h"
+#include "llllib.h"
+#include "rsa.h"
+#include "thread_pool.h"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+// ─── Record Reader ───────────────────────────────────────────────────────
+
+bool RecordReader::next(RSARecord& record) {
+    std::string content;
+    while (std::getline(in_, content)) {
+        ++line_;
+        size_t first = content.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos || content[first] == '#') continue;
+
+        std::vector<std::string> numbers;
+        std::stringstream ss(content);
+        std::string token;
+        while (std::getline(ss, token, ',')) {
+            token.erase(0, token.find_first_not_of(" \t\r\n"));
+            token.erase(token.find_last_not_of(" \t\r\n") + 1);
+            if (!token.empty()) {
+                numbers.push_back(token);
+            }
+        }
+        if (numbers.size() != 4 && numbers.size() != 5) {
+            throw std::runtime_error("Line " + std::to_string(line_) + ": expected 4 or 5 numbers, found "
+                                     + std::to_string(numbers.size()));
+        }
+
+        record = RSARecord();
+        record.index = index_++;
+        record.line = line_;
+        mpz_class* fields[] = {&record.n, &record.d, &record.p0, &record.X, &record.c};
+        for (size_t i = 0; i < numbers.size(); ++i) {
+            if (fields[i]->set_str(numbers[i], 10) != 0) {
+                throw std::runtime_error("Line " + std::to_string(line_) + ": invalid number in field "
+                                         + std::to_string(i + 1));
+            }
+        }
+        record.has_ciphertext = numbers.size() == 5;
+        return true;
+    }
+    return false;
+}
+
+// ─── Results ─────────────────────────────────────────────────────────────
+
+void write_result(std::ostream& out, const RSAResult& result) {
+    out << result.index << ",";
+    if (!result.ok) {
+        out << "error," << result.error << "\n";
+        return;
+    }
+    out << "ok," << result.p << "," << result.q << "," << result.e;
+    if (result.has_plaintext) {
+        out << "," << result.m;
+    }
+    out << "\n";
+}
+
+// ─── Pipeline Stages ─────────────────────────────────────────────────────
+
+namespace {
+
+// Everything one record carries between stages
+struct Job {
+    RSARecord record;
+    RSAResult result;
+    IntMatrix lattice;
+    std::vector<mpz_class> reduced;
+    std::vector<mpz_class> roots;
+    CRTKey key;
+};
+
+// Rows (x + p0)², n·x, n, highest degree first as in main.cpp
+void build_lattice(Job& job) {
+    const RSARecord& r = job.record;
+    if (r.n <= 0 || r.X <= 0) {
+        throw std::invalid_argument("n and X must be positive");
+    }
+    job.lattice = {
+        {mpz_class(1), 2 * r.p0, r.p0 * r.p0},
+        {mpz_class(0), r.n, mpz_class(0)},
+        {mpz_class(0), mpz_class(0), r.n}
+    };
+}
+
+void reduce_lattice(Job& job) {
+    job.reduced = lll(job.lattice, job.record.X);
+    job.lattice = IntMatrix();
+}
+
+void find_roots(Job& job) {
+    Polynomial h{job.reduced[2], job.reduced[1], job.reduced[0]};
+    if (degree(h) < 1) {
+        throw std::runtime_error("reduced vector is not a polynomial in x");
+    }
+    job.roots = integer_roots(h, job.record.X);
+    if (job.roots.empty()) {
+        throw std::runtime_error("no integer root with |x| <= X");
+    }
+}
+
+void recover_key(Job& job) {
+    const RSARecord& r = job.record;
+    RSAResult& result = job.result;
+    for (const auto& x : job.roots) {
+        mpz_class candidate = r.p0 + x;
+        if (candidate > 1 && candidate < r.n && mpz_divisible_p(r.n.get_mpz_t(), candidate.get_mpz_t())) {
+            result.p = candidate;
+            result.q = r.n / candidate;
+            break;
+        }
+    }
+    if (result.p == 0) {
+        throw std::runtime_error("no root gave a factor of n");
+    }
+    mpz_class phi_n = (result.p - 1) * (result.q - 1);
+    if (mpz_invert(result.e.get_mpz_t(), r.d.get_mpz_t(), phi_n.get_mpz_t()) == 0) {
+        throw std::runtime_error("d is not invertible modulo phi(n)");
+    }
+    if (r.has_ciphertext) {
+        job.key = make_crt_key(result.p, result.q, result.e);
+    }
+}
+
+void decrypt(Job& job) {
+    if (!job.record.has_ciphertext) return;
+    job.result.m = crt_decrypt(job.key, job.record.c);
+    job.result.has_plaintext = true;
+}
+
+void (*const stages[STAGE_COUNT])(Job&) = {
+    build_lattice, reduce_lattice, find_roots, recover_key, decrypt
+};
+
+// Run one stage over every live job of the window, catching failures per job
+void run_stage(ThreadPool& pool, std::vector<Job>& window, PipelineStage stage, PipelineStats& stats) {
+    size_t live = 0;
+    for (const auto& job : window) {
+        if (job.result.error.empty()) ++live;
+    }
+    if (live == 0) return;
+
+    auto start = std::chrono::steady_clock::now();
+    pool.parallel_for(window.size(), [&](size_t i) {
+        Job& job = window[i];
+        if (!job.result.error.empty()) return;
+        try {
+            stages[stage](job);
+        } catch (const std::exception& ex) {
+            job.result.error = std::string(stage_name(stage)) + ": " + ex.what();
+        }
+    });
+    auto end = std::chrono::steady_clock::now();
+
+    stats.stage_seconds[stage] += std::chrono::duration<double>(end - start).count();
+    stats.stage_records[stage] += live;
+}
+
+} // namespace
+
+// ─── Driver ──────────────────────────────────────────────────────────────
+
+const char* stage_name(PipelineStage stage) {
+    switch (stage) {
+        case STAGE_LATTICE: return "lattice";
+        case STAGE_REDUCTION: return "reduction";
+        case STAGE_ROOTS: return "roots";
+        case STAGE_KEY: return "key";
+        case STAGE_DECRYPT: return "decrypt";
+        default: return "?";
+    }
+}
+
+PipelineStats run_pipeline(std::istream& in, std::ostream& out, const PipelineOptions& options) {
+    RecordReader reader(in);
+    return run_pipeline([&](RSARecord& record) { return reader.next(record); }, out, options);
+}
+
+PipelineStats run_pipeline(const std::function<bool(RSARecord&)>& next, std::ostream& out,
+                           const PipelineOptions& options) {
+    ThreadPool pool(options.threads);
+    size_t window_size = options.window ? options.window : 4 * pool.size();
+
+    PipelineStats stats;
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Job> window;
+    bool more = true;
+    while (more) {
+        window.clear();
+        RSARecord record;
+        while (window.size() < window_size && (more = next(record))) {
+            Job job;
+            job.result.index = record.index;
+            job.result.line = record.line;
+            job.record = std::move(record);
+            window.push_back(std::move(job));
+        }
+        if (window.empty()) break;
+
+        for (size_t s = 0; s < STAGE_COUNT; ++s) {
+            run_stage(pool, window, static_cast<PipelineStage>(s), stats);
+        }
+
+        for (auto& job : window) {
+            job.result.ok = job.result.error.empty();
+            if (!job.result.ok) ++stats.failures;
+            write_result(out, job.result);
+        }
+        out.flush();
+        stats.records += window.size();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    stats.total_seconds = std::chrono::duration<double>(end - start).count();
+    return stats;
+}
+
+void write_pipeline_stats(std::ostream& out, const PipelineStats& stats) {
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << std::left << std::setw(12) << "stage"
+        << std::right << std::setw(10) << "records"
+        << std::setw(12) << "seconds"
+        << std::setw(14) << "records/s" << "\n";
+    out << std::fixed << std::setprecision(3);
+    for (size_t s = 0; s < STAGE_COUNT; ++s) {
+        double seconds = stats.stage_seconds[s];
+        out << std::left << std::setw(12) << stage_name(static_cast<PipelineStage>(s))
+            << std::right << std::setw(10) << stats.stage_records[s]
+            << std::setw(12) << seconds
+            << std::setw(14) << (seconds > 0 ? stats.stage_records[s] / seconds : 0.0) << "\n";
+    }
+    out << std::left << std::setw(12) << "total"
+        << std::right << std::setw(10) << stats.records
+        << std::setw(12) << stats.total_seconds
+        << std::setw(14) << (stats.total_seconds > 0 ? stats.records / stats.total_seconds : 0.0) << "\n";
+    out << stats.failures << " of " << stats.records << " records failed\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,144 @@
+#ifndef RSA_PIPELINE_H
+#define RSA_PIPELINE_H
+
+#include <array>
+#include <functional>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <gmpxx.h>
+
+// ─── Instance Records ────────────────────────────────────────────────────
+
+/**
+ * One attack instance: modulus n, public exponent d, approximation p0 of
+ * the factor p with |p − p0| ≤ X, and optionally a ciphertext c.
+ */
+struct RSARecord {
+    size_t index = 0;          // position in the input, from 0
+    size_t line = 0;           // line number in the input, from 1
+    mpz_class n;
+    mpz_class d;
+    mpz_class p0;
+    mpz_class X;
+    bool has_ciphertext = false;
+    mpz_class c;
+};
+
+/**
+ * Streaming reader for record files. Each non-empty line holds
+ * "n, d, p0, X" or "n, d, p0, X, c" in decimal; lines starting with '#'
+ * are comments. A single-record lab file is a valid input.
+ */
+class RecordReader {
+public:
+    explicit RecordReader(std::istream& in) : in_(in) {}
+
+    /**
+     * Read the next record.
+     * @return false at the end of the input.
+     * @throws std::runtime_error on a malformed line (with its line number).
+     */
+    bool next(RSARecord& record);
+
+private:
+    std::istream& in_;
+    size_t line_ = 0;
+    size_t index_ = 0;
+};
+
+// ─── Attack Results ──────────────────────────────────────────────────────
+
+/**
+ * Outcome of one record. On success p·q = n, p = p0 + x with |x| ≤ X, and
+ * e is the private exponent d⁻¹ mod φ(n); m = c^e mod n when the record
+ * carried a ciphertext.
+ */
+struct RSAResult {
+    size_t index = 0;
+    size_t line = 0;
+    bool ok = false;
+    std::string error;
+    mpz_class p;
+    mpz_class q;
+    mpz_class e;
+    bool has_plaintext = false;
+    mpz_class m;
+};
+
+/**
+ * Write a result as one CSV line:
+ *     index,ok,p,q,e[,m]    or    index,error,<message>
+ */
+void write_result(std::ostream& out, const RSAResult& result);
+
+// ─── Pipeline ────────────────────────────────────────────────────────────
+
+enum PipelineStage {
+    STAGE_LATTICE,      // Coppersmith lattice for (x + p0)² mod p
+    STAGE_REDUCTION,    // lll(M, X)
+    STAGE_ROOTS,        // integer roots of the short polynomial
+    STAGE_KEY,          // p, q, the private exponent and its CRT form
+    STAGE_DECRYPT,      // m = c^e mod n by CRT
+    STAGE_COUNT
+};
+
+/**
+ * Human-readable stage name.
+ */
+const char* stage_name(PipelineStage stage);
+
+/**
+ * Per-stage accounting of a pipeline run. stage_seconds is the wall time
+ * the pool spent in each stage and stage_records the number of records
+ * that entered it (records that failed earlier skip the later stages).
+ */
+struct PipelineStats {
+    size_t records = 0;
+    size_t failures = 0;
+    std::array<double, STAGE_COUNT> stage_seconds{};
+    std::array<size_t, STAGE_COUNT> stage_records{};
+    double total_seconds = 0;
+};
+
+/**
+ * Table of records, seconds and records per second for every stage.
+ */
+void write_pipeline_stats(std::ostream& out, const PipelineStats& stats);
+
+/**
+ * Options of run_pipeline.
+ */
+struct PipelineOptions {
+    size_t threads = 0;    // total threads including the caller (0 = one per core)
+    size_t window = 0;     // records in flight (0 = 4 per thread)
+};
+
+/**
+ * Run the Coppersmith factoring attack on every record of a stream.
+ *
+ * Records are read a window at a time. Each stage then runs over the whole
+ * window on a ThreadPool before the next stage starts, and the window's
+ * results are written in input order and flushed before the next window
+ * is read, so output appears incrementally and memory stays bounded by the
+ * window size. A record that fails a stage is reported and skips the
+ * remaining ones; it does not stop the batch.
+ *
+ * @param in Record stream (see RecordReader).
+ * @param out Receives one write_result line per record.
+ * @param options Thread count and window size.
+ * @return Per-stage statistics.
+ * @throws std::runtime_error on a malformed input line.
+ */
+PipelineStats run_pipeline(std::istream& in, std::ostream& out,
+                           const PipelineOptions& options = PipelineOptions());
+
+/**
+ * run_pipeline on records from any source, e.g. a binary record table.
+ * next fills in the following record and returns false at the end.
+ */
+PipelineStats run_pipeline(const std::function<bool(RSARecord&)>& next, std::ostream& out,
+                           const PipelineOptions& options = PipelineOptions());
+
+#endif // RSA_PIPELINE_H
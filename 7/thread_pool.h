@@ -0,0 +1,58 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed-size pool of worker threads for data-parallel loops.
+ *
+ * parallel_for hands out indices dynamically, the calling thread works
+ * alongside the pool, and the call blocks until every index is done.
+ * Only one parallel_for may run at a time, and it must not be called
+ * from inside one of its own tasks.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threads Total threads including the caller (0 = one per core).
+     */
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers_.size() + 1; }
+
+    /**
+     * Run fn(i) for every i in [0, count). The first exception thrown by a
+     * task is rethrown here once all tasks have finished.
+     */
+    void parallel_for(size_t count, const std::function<void(size_t)>& fn);
+
+private:
+    void worker_loop();
+    void run_tasks();
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    bool stop_ = false;
+    size_t generation_ = 0;
+    size_t busy_ = 0;
+
+    const std::function<void(size_t)>* fn_ = nullptr;
+    size_t count_ = 0;
+    std::atomic<size_t> next_{0};
+    std::exception_ptr error_;
+};
+
+#endif // THREAD_POOL_H